@@ -0,0 +1,688 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitter2Batch.h
+/// \brief Batched version of the 2-prongs DCAFitterN: minimizes many track pairs at once in SoA lanes
+///
+/// The seeding (circles crossing, propagation of the tracks to the seed) is done per pair as in the DCAFitterN,
+/// while the Newton iterations, which for the fixed seed involve only the analytic corrections of the track
+/// positions, are performed for NLanes hypotheses at once on structure-of-arrays of value_t, written as
+/// branchless loops over the lanes to be vectorized by the compiler.
+/// The convergence logic (incl. the preference to alternative seed) is the same as in the DCAFitterN.
+/// Only the Bz propagation w/o material corrections is supported.
+
+#ifndef _ALICEO2_DCA_FITTER2_BATCH_
+#define _ALICEO2_DCA_FITTER2_BATCH_
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include "DCAFitter/DCAFitterN.h"
+
+namespace o2
+{
+namespace vertexing
+{
+
+template <typename value_T = double, int NLanes = 8>
+class DCAFitter2Batch
+{
+ public:
+  using value_t = value_T;
+  using Track = o2::track::TrackParCov;
+  using TrackAuxPar = o2::track::TrackAuxPar;
+  using CrossInfo = o2::track::CrossInfo;
+  static constexpr int N = 2;
+  static constexpr int MAXHYP = 2;
+  static constexpr double NInv = 1. / N;
+  static constexpr float XerrFactor = 5.; // factor for conversion of track covYY to dummy covXX, as in the DCAFitterN
+
+  static constexpr int getNProngs() { return N; }
+  static constexpr int getNLanes() { return NLanes; }
+
+  DCAFitter2Batch() = default;
+  DCAFitter2Batch(float bz, bool useAbsDCA, bool prop2DCA) : mBz(bz), mUseAbsDCA(useAbsDCA), mPropagateToPCA(prop2DCA) {}
+
+  ///< take settings from the scalar fitter, return false if it uses options not supported by the batched version
+  template <typename... Args>
+  bool configureFrom(const DCAFitterN<2, Args...>& ft);
+
+  void setPropagateToPCA(bool v = true) { mPropagateToPCA = v; }
+  void setMaxIter(int n = 20) { mMaxIter = n > 2 ? n : 2; }
+  void setMaxR(float r = 200.) { mMaxR2 = r * r; }
+  void setMaxDZIni(float d = 4.) { mMaxDZIni = d; }
+  void setMaxDXYIni(float d = 4.) { mMaxDXYIni = d > 0 ? d : 1e9; }
+  void setMaxChi2(float chi2 = 999.) { mMaxChi2 = chi2; }
+  void setBz(float bz) { mBz = std::abs(bz) > o2::constants::math::Almost0 ? bz : 0.f; }
+  void setMinParamChange(float x = 1e-3) { mMinParamChange = x > 1e-4 ? x : 1.e-4; }
+  void setMinRelChi2Change(float r = 0.9) { mMinRelChi2Change = r > 0.1 ? r : 999.; }
+  void setUseAbsDCA(bool v) { mUseAbsDCA = v; }
+  void setMaxDistance2ToMerge(float v) { mMaxDist2ToMergeSeeds = v; }
+  void setMinXSeed(float x) { mMinXSeed = x; }
+  void setCollinear(bool isCollinear) { mIsCollinear = isCollinear; }
+
+  int getMaxIter() const { return mMaxIter; }
+  float getMaxR() const { return std::sqrt(mMaxR2); }
+  float getMaxChi2() const { return mMaxChi2; }
+  float getBz() const { return mBz; }
+  bool getUseAbsDCA() const { return mUseAbsDCA; }
+  bool getPropagateToPCA() const { return mPropagateToPCA; }
+
+  ///< register the pair of tracks to fit, the tracks must stay alive until the results are used. Returns the pair ID
+  int addPair(const Track& t0, const Track& t1)
+  {
+    mPairs.push_back({&t0, &t1});
+    return mPairs.size() - 1;
+  }
+  ///< forget all pairs and results
+  void clear()
+  {
+    mPairs.clear();
+    mResults.clear();
+    mHyps.clear();
+  }
+  int getNPairs() const { return mPairs.size(); }
+
+  ///< fit all registered pairs, return total number of found candidates
+  int process();
+
+  //=========================================================================
+  // results per pair, candidates are ordered in quality as in the DCAFitterN
+
+  int getNCandidates(int ip) const { return mResults[ip].nCand; }
+  std::array<float, 3> getPCACandidatePos(int ip, int cand = 0) const
+  {
+    const auto& h = getHyp(ip, cand);
+    return {float(h.pca[0]), float(h.pca[1]), float(h.pca[2])};
+  }
+  float getChi2AtPCACandidate(int ip, int cand = 0) const { return getHyp(ip, cand).chi2; }
+  int getNIterations(int ip, int cand = 0) const { return getHyp(ip, cand).nIter; }
+  bool isPropagateTracksToVertexDone(int ip, int cand = 0) const { return getHyp(ip, cand).propDone; }
+  bool propagateTracksToVertex(int ip, int cand = 0) { return propagateTracksToVertex(getHyp(ip, cand)); }
+  const Track& getTrack(int ip, int i, int cand = 0) const
+  {
+    const auto& h = getHyp(ip, cand);
+    if (!h.propDone) {
+      throw std::runtime_error("propagateTracksToVertex was not called yet");
+    }
+    return h.tracks[i];
+  }
+  const Track* getOrigTrackPtr(int ip, int i) const { return mPairs[ip][i]; }
+
+  void print() const;
+
+ private:
+  enum Status : int { Active,
+                      Converged,
+                      Failed,
+                      FailedAlt };
+
+  struct Hypothesis {
+    int pairID = -1;
+    std::array<Track, N> tracks;                // tracks at the seed, after propagateTracksToVertex - at the PCA
+    std::array<float, N> c{}, s{};              // cos and sin of the tracks alpha
+    float curX = 0, curY = 0, altX = 0, altY = 0; // current and alternative seeds
+    bool useAlt = false;                        // abandon the hypothesis if it converges to alternative seed
+    std::array<value_t, 3> pca{};               // fitted PCA
+    float chi2 = -1.;                           // chi2 at PCA
+    int nIter = 0;                              // number of iterations
+    int status = Failed;
+    bool propDone = false;
+  };
+
+  struct PairResult {
+    int nCand = 0;
+    std::array<int, MAXHYP> hyps{}; // hypotheses of the pair, ordered in quality
+  };
+
+  // SoA data of NLanes hypotheses being minimized together
+  template <typename T>
+  using Lanes = std::array<T, NLanes>;
+  using VLanes = Lanes<value_t>;
+  struct LaneBlock {
+    std::array<VLanes, N> c, s, x, y, z;                            // track frame and position in it
+    std::array<VLanes, N> dydx, dzdx, d2ydx2, d2zdx2;               // track derivatives over X
+    std::array<VLanes, N> sxx, syy, syz, szz;                       // track inverse covariance
+    std::array<std::array<VLanes, 9>, N> tcf;                       // PCA decomposition coefficients, see DCAFitterN::calcPCACoefs
+    std::array<std::array<std::array<VLanes, 3>, N>, N> dr1, dr2;   // 1st and 2nd derivatives of residual i over X of track j
+    std::array<VLanes, 3> pca;                                      // current PCA
+    std::array<std::array<VLanes, 3>, N> res;                       // current residuals
+    VLanes curX, curY, altX, altY;                                  // current and alternative seeds
+    Lanes<float> chi2;                                              // current chi2 (float as in the DCAFitterN)
+    Lanes<int> nIter, status;
+    Lanes<bool> useAlt;
+  };
+
+  const Hypothesis& getHyp(int ip, int cand) const { return mHyps[mResults[ip].hyps[cand]]; }
+  Hypothesis& getHyp(int ip, int cand) { return mHyps[mResults[ip].hyps[cand]]; }
+
+  void seedPair(int ip);
+  void minimize(const std::vector<int>& hypIDs);
+  void loadLanes(LaneBlock& blk, const std::vector<int>& hypIDs, size_t first);
+  void storeLanes(const LaneBlock& blk, const std::vector<int>& hypIDs, size_t first);
+  void initLanes(LaneBlock& blk) const;
+  void initLanesNoErr(LaneBlock& blk) const;
+  void iterateLanes(LaneBlock& blk) const;
+  bool propagateTracksToVertex(Hypothesis& h);
+
+  std::vector<std::array<const Track*, N>> mPairs;
+  std::vector<PairResult> mResults;
+  std::vector<Hypothesis> mHyps;
+
+  bool mUseAbsDCA = false;          // use abs. distance minimization rather than chi2
+  bool mPropagateToPCA = true;      // create tracks version propagated to PCA
+  bool mIsCollinear = false;        // use collinear fits when there 2 crossing points
+  int mMaxIter = 20;                // max number of iterations
+  float mBz = 0;                    // bz field, to be set by user
+  float mMaxR2 = 200. * 200.;       // reject PCA's above this radius
+  float mMinXSeed = -50.;           // reject seed if it corresponds to X-param < mMinXSeed for one of candidates
+  float mMaxDZIni = 4.;             // reject (if>0) PCA candidate if tracks DZ exceeds threshold
+  float mMaxDXYIni = 4.;            // reject (if>0) PCA candidate if tracks dXY exceeds threshold
+  float mMinParamChange = 1e-3;     // stop iterations if largest change of any X is smaller than this
+  float mMinRelChi2Change = 0.9;    // stop iterations is chi2/chi2old > this
+  float mMaxChi2 = 100;             // abs cut on chi2 or abs distance
+  float mMaxDist2ToMergeSeeds = 1.; // merge 2 seeds to their average if their distance^2 is below the threshold
+};
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+template <typename... Args>
+bool DCAFitter2Batch<value_T, NLanes>::configureFrom(const DCAFitterN<2, Args...>& ft)
+{
+  mUseAbsDCA = ft.getUseAbsDCA();
+  mPropagateToPCA = ft.getPropagateToPCA();
+  mIsCollinear = ft.getCollinear();
+  mMaxIter = ft.getMaxIter();
+  mBz = ft.getBz();
+  mMaxR2 = ft.getMaxR() * ft.getMaxR();
+  mMinXSeed = ft.getMinXSeed();
+  mMaxDZIni = ft.getMaxDZIni();
+  mMaxDXYIni = ft.getMaxDXYIni();
+  mMinParamChange = ft.getMinParamChange();
+  mMinRelChi2Change = ft.getMinRelChi2Change();
+  mMaxChi2 = ft.getMaxChi2();
+  mMaxDist2ToMergeSeeds = ft.getMaxDistance2ToMerge();
+  if (ft.getUsePropagator() || ft.getMatCorrType() != o2::base::Propagator::MatCorrType::USEMatCorrNONE || ft.getRefitWithMatCorr() || ft.getWeightedFinalPCA()) {
+    LOG(error) << "DCAFitter2Batch supports only Bz propagation w/o material corrections, refit or weighted final PCA";
+    return false;
+  }
+  return true;
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+int DCAFitter2Batch<value_T, NLanes>::process()
+{
+  // This is a main entry point: fit PCA of all registered pairs
+  mHyps.clear();
+  mResults.clear();
+  mResults.resize(mPairs.size());
+  for (int ip = 0; ip < (int)mPairs.size(); ip++) {
+    seedPair(ip);
+  }
+  std::vector<int> hypIDs(mHyps.size());
+  for (int ih = 0; ih < (int)mHyps.size(); ih++) {
+    hypIDs[ih] = ih;
+  }
+  minimize(hypIDs);
+
+  // In the DCAFitterN the 2nd seed is tested w/o alternative check if the 1st one has converged to it.
+  // Here both seeds were minimized at once, so the 2nd one is redone if it was rejected due to this check.
+  hypIDs.clear();
+  for (auto& res : mResults) {
+    if (res.nCand == MAXHYP && mHyps[res.hyps[0]].status == FailedAlt && mHyps[res.hyps[1]].status == FailedAlt) {
+      auto& h = mHyps[res.hyps[1]];
+      h.useAlt = false;
+      h.status = Active;
+      hypIDs.push_back(res.hyps[1]);
+    }
+  }
+  if (hypIDs.size()) {
+    minimize(hypIDs);
+  }
+
+  // select and order the candidates
+  int nCandTot = 0;
+  for (auto& res : mResults) {
+    int nc = 0;
+    for (int ic = 0; ic < res.nCand; ic++) {
+      auto& h = mHyps[res.hyps[ic]];
+      if (h.status != Converged || h.chi2 >= mMaxChi2) {
+        continue;
+      }
+      if (mPropagateToPCA && !propagateTracksToVertex(h)) {
+        continue; // discard candidate if failed to propagate to it
+      }
+      res.hyps[nc++] = res.hyps[ic];
+    }
+    res.nCand = nc;
+    if (nc == MAXHYP && mHyps[res.hyps[1]].chi2 < mHyps[res.hyps[0]].chi2) {
+      std::swap(res.hyps[0], res.hyps[1]);
+    }
+    nCandTot += nc;
+  }
+  return nCandTot;
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::seedPair(int ip)
+{
+  // find seeds for the pair and propagate tracks to them, as in the DCAFitterN::process
+  const auto& trcs = mPairs[ip];
+  std::array<TrackAuxPar, N> aux;
+  for (int i = 0; i < N; i++) {
+    aux[i].set(*trcs[i], mBz);
+  }
+  CrossInfo crossings;
+  if (!crossings.set(aux[0], *trcs[0], aux[1], *trcs[1], mMaxDXYIni, mIsCollinear)) {
+    return; // no crossing
+  }
+  if (crossings.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
+    auto dst2 = (crossings.xDCA[0] - crossings.xDCA[1]) * (crossings.xDCA[0] - crossings.xDCA[1]) +
+                (crossings.yDCA[0] - crossings.yDCA[1]) * (crossings.yDCA[0] - crossings.yDCA[1]);
+    if (dst2 < mMaxDist2ToMergeSeeds) {
+      crossings.nDCA = 1;
+      crossings.xDCA[0] = 0.5 * (crossings.xDCA[0] + crossings.xDCA[1]);
+      crossings.yDCA[0] = 0.5 * (crossings.yDCA[0] + crossings.yDCA[1]);
+    }
+  }
+  auto& res = mResults[ip];
+  for (int ic = 0; ic < crossings.nDCA; ic++) {
+    if (crossings.xDCA[ic] * crossings.xDCA[ic] + crossings.yDCA[ic] * crossings.yDCA[ic] > mMaxR2) {
+      continue;
+    }
+    Hypothesis h;
+    h.pairID = ip;
+    h.curX = crossings.xDCA[ic];
+    h.curY = crossings.yDCA[ic];
+    h.useAlt = crossings.nDCA == MAXHYP;
+    if (h.useAlt) {
+      h.altX = crossings.xDCA[1 - ic];
+      h.altY = crossings.yDCA[1 - ic];
+    }
+    bool ok = true;
+    for (int i = 0; i < N && ok; i++) {
+      h.c[i] = aux[i].c;
+      h.s[i] = aux[i].s;
+      h.tracks[i] = *trcs[i];
+      auto x = aux[i].c * h.curX + aux[i].s * h.curY; // X of PCA in the track frame
+      ok = x >= mMinXSeed && (mUseAbsDCA ? h.tracks[i].propagateParamTo(x, mBz) : h.tracks[i].propagateTo(x, mBz));
+    }
+    if (!ok || (mMaxDZIni > 0 && std::abs(h.tracks[0].getZ() - h.tracks[1].getZ()) > mMaxDZIni)) {
+      continue;
+    }
+    h.status = Active;
+    res.hyps[res.nCand++] = mHyps.size();
+    mHyps.push_back(h);
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::minimize(const std::vector<int>& hypIDs)
+{
+  LaneBlock blk{};
+  for (size_t first = 0; first < hypIDs.size(); first += NLanes) {
+    loadLanes(blk, hypIDs, first);
+    if (mUseAbsDCA) {
+      initLanesNoErr(blk);
+    } else {
+      initLanes(blk);
+    }
+    for (int iter = 0; iter < mMaxIter; iter++) {
+      bool anyActive = false;
+      for (int l = 0; l < NLanes; l++) {
+        anyActive |= blk.status[l] == Active;
+      }
+      if (!anyActive) {
+        break;
+      }
+      iterateLanes(blk);
+    }
+    storeLanes(blk, hypIDs, first);
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::loadLanes(LaneBlock& blk, const std::vector<int>& hypIDs, size_t first)
+{
+  // fill SoA block from the hypotheses, the unused lanes are filled by copies of the 1st one but flagged as failed
+  for (int l = 0; l < NLanes; l++) {
+    bool used = first + l < hypIDs.size();
+    const auto& h = mHyps[hypIDs[used ? first + l : first]];
+    for (int i = 0; i < N; i++) {
+      const auto& trc = h.tracks[i];
+      TrackDeriv der(trc, mBz);
+      blk.c[i][l] = h.c[i];
+      blk.s[i][l] = h.s[i];
+      blk.x[i][l] = trc.getX();
+      blk.y[i][l] = trc.getY();
+      blk.z[i][l] = trc.getZ();
+      blk.dydx[i][l] = der.dydx;
+      blk.dzdx[i][l] = der.dzdx;
+      blk.d2ydx2[i][l] = der.d2ydx2;
+      blk.d2zdx2[i][l] = der.d2zdx2;
+      if (!mUseAbsDCA) {
+        TrackCovI cov(trc, XerrFactor);
+        blk.sxx[i][l] = cov.sxx;
+        blk.syy[i][l] = cov.syy;
+        blk.syz[i][l] = cov.syz;
+        blk.szz[i][l] = cov.szz;
+      }
+    }
+    blk.curX[l] = h.curX;
+    blk.curY[l] = h.curY;
+    blk.altX[l] = h.altX;
+    blk.altY[l] = h.altY;
+    blk.useAlt[l] = h.useAlt;
+    blk.nIter[l] = 0;
+    blk.status[l] = used ? Active : Failed;
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::storeLanes(const LaneBlock& blk, const std::vector<int>& hypIDs, size_t first)
+{
+  for (int l = 0; l < NLanes && first + l < hypIDs.size(); l++) {
+    auto& h = mHyps[hypIDs[first + l]];
+    h.status = blk.status[l] == Active ? Converged : blk.status[l]; // max.iterations reached
+    h.nIter = blk.nIter[l];
+    h.chi2 = blk.chi2[l] * NInv;
+    for (int k = 0; k < 3; k++) {
+      h.pca[k] = blk.pca[k][l];
+    }
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::initLanes(LaneBlock& blk) const
+{
+  // weighted distance minimization: calculate PCA decomposition coefficients (see DCAFitterN::calcPCACoefs) and
+  // residuals derivatives (see DCAFitterN::calcResidDerivatives), which stay constant during the iterations
+  for (int l = 0; l < NLanes; l++) {
+    // [sum_{0<j<N} M_j*E_j*M_j^T] and its inverse
+    value_t wxx = 0, wxy = 0, wyy = 0, wxz = 0, wyz = 0, wzz = 0;
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      wxx += c * c * blk.sxx[i][l] + s * s * blk.syy[i][l];
+      wxy += c * s * (blk.sxx[i][l] - blk.syy[i][l]);
+      wxz += -s * blk.syz[i][l];
+      wyy += c * c * blk.syy[i][l] + s * s * blk.sxx[i][l];
+      wyz += c * blk.syz[i][l];
+      wzz += blk.szz[i][l];
+    }
+    value_t cxx = wyy * wzz - wyz * wyz, cxy = wxz * wyz - wxy * wzz, cxz = wxy * wyz - wyy * wxz;
+    value_t cyy = wxx * wzz - wxz * wxz, cyz = wxy * wxz - wxx * wyz, czz = wxx * wyy - wxy * wxy;
+    value_t det = wxx * cxx + wxy * cxy + wxz * cxz;
+    blk.status[l] = det == 0 ? int(Failed) : blk.status[l];
+    value_t detI = det == 0 ? value_t(0) : value_t(1) / det;
+    const value_t winv[9] = {cxx * detI, cxy * detI, cxz * detI, cxy * detI, cyy * detI, cyz * detI, cxz * detI, cyz * detI, czz * detI};
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      const value_t miei[9] = {c * blk.sxx[i][l], -s * blk.syy[i][l], -s * blk.syz[i][l],
+                               s * blk.sxx[i][l], c * blk.syy[i][l], c * blk.syz[i][l],
+                               0, blk.syz[i][l], blk.szz[i][l]};
+      for (int r = 0; r < 3; r++) {
+        for (int k = 0; k < 3; k++) {
+          blk.tcf[i][r * 3 + k][l] = winv[r * 3] * miei[k] + winv[r * 3 + 1] * miei[3 + k] + winv[r * 3 + 2] * miei[6 + k];
+        }
+      }
+    }
+    for (int i = N; i--;) { // residual being differentiated
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      for (int j = N; j--;) { // track over which we differentiate
+        const auto& t = blk.tcf[j];
+        value_t mt[9]; // M_i^tr * T_j
+        for (int k = 0; k < 3; k++) {
+          mt[k] = c * t[k][l] + s * t[3 + k][l];
+          mt[3 + k] = -s * t[k][l] + c * t[3 + k][l];
+          mt[6 + k] = t[6 + k][l];
+        }
+        for (int k = 0; k < 3; k++) {
+          blk.dr1[i][j][k][l] = -(mt[3 * k] + mt[3 * k + 1] * blk.dydx[j][l] + mt[3 * k + 2] * blk.dzdx[j][l]);
+          blk.dr2[i][j][k][l] = -(mt[3 * k + 1] * blk.d2ydx2[j][l] + mt[3 * k + 2] * blk.d2zdx2[j][l]);
+        }
+        if (i == j) {
+          blk.dr1[i][j][0][l] += 1.;
+          blk.dr1[i][j][1][l] += blk.dydx[j][l];
+          blk.dr1[i][j][2][l] += blk.dzdx[j][l];
+          blk.dr2[i][j][1][l] += blk.d2ydx2[j][l];
+          blk.dr2[i][j][2][l] += blk.d2zdx2[j][l];
+        }
+      }
+    }
+  }
+  // initial PCA, residuals and chi2
+  for (int l = 0; l < NLanes; l++) {
+    for (int k = 0; k < 3; k++) {
+      blk.pca[k][l] = 0;
+      for (int i = N; i--;) {
+        blk.pca[k][l] += blk.tcf[i][3 * k][l] * blk.x[i][l] + blk.tcf[i][3 * k + 1][l] * blk.y[i][l] + blk.tcf[i][3 * k + 2][l] * blk.z[i][l];
+      }
+    }
+    value_t chi2 = 0;
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      auto& res = blk.res[i];
+      res[0][l] = blk.x[i][l] - (c * blk.pca[0][l] + s * blk.pca[1][l]);
+      res[1][l] = blk.y[i][l] - (-s * blk.pca[0][l] + c * blk.pca[1][l]);
+      res[2][l] = blk.z[i][l] - blk.pca[2][l];
+      chi2 += res[0][l] * res[0][l] * blk.sxx[i][l] + res[1][l] * res[1][l] * blk.syy[i][l] + res[2][l] * res[2][l] * blk.szz[i][l] + 2. * res[1][l] * res[2][l] * blk.syz[i][l];
+    }
+    blk.chi2[l] = chi2;
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::initLanesNoErr(LaneBlock& blk) const
+{
+  // absolute distance minimization: calculate residuals derivatives (see DCAFitterN::calcResidDerivativesNoErr),
+  // which stay constant during the iterations
+  constexpr value_t NInv1 = 1. - NInv;
+  for (int l = 0; l < NLanes; l++) {
+    for (int i = N; i--;) {
+      blk.dr1[i][i][0][l] = NInv1;
+      blk.dr1[i][i][1][l] = NInv1 * blk.dydx[i][l];
+      blk.dr1[i][i][2][l] = NInv1 * blk.dzdx[i][l];
+      blk.dr2[i][i][0][l] = 0;
+      blk.dr2[i][i][1][l] = NInv1 * blk.d2ydx2[i][l];
+      blk.dr2[i][i][2][l] = NInv1 * blk.d2zdx2[i][l];
+    }
+    // M_1^T*M_0 / N non-trivial elements
+    value_t cij = (blk.c[1][l] * blk.c[0][l] + blk.s[1][l] * blk.s[0][l]) * NInv;
+    value_t sij = (blk.s[1][l] * blk.c[0][l] - blk.c[1][l] * blk.s[0][l]) * NInv;
+    blk.dr1[1][0][0][l] = -(cij + sij * blk.dydx[0][l]);
+    blk.dr1[1][0][1][l] = -(-sij + cij * blk.dydx[0][l]);
+    blk.dr1[1][0][2][l] = -blk.dzdx[0][l] * NInv;
+    blk.dr1[0][1][0][l] = -(cij - sij * blk.dydx[1][l]);
+    blk.dr1[0][1][1][l] = -(sij + cij * blk.dydx[1][l]);
+    blk.dr1[0][1][2][l] = -blk.dzdx[1][l] * NInv;
+    blk.dr2[1][0][0][l] = -sij * blk.d2ydx2[0][l];
+    blk.dr2[1][0][1][l] = -cij * blk.d2ydx2[0][l];
+    blk.dr2[1][0][2][l] = -blk.d2zdx2[0][l] * NInv;
+    blk.dr2[0][1][0][l] = sij * blk.d2ydx2[1][l];
+    blk.dr2[0][1][1][l] = -cij * blk.d2ydx2[1][l];
+    blk.dr2[0][1][2][l] = -blk.d2zdx2[1][l] * NInv;
+  }
+  // initial PCA, residuals and chi2
+  for (int l = 0; l < NLanes; l++) {
+    value_t px = 0, py = 0, pz = 0;
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      px += c * blk.x[i][l] - s * blk.y[i][l];
+      py += s * blk.x[i][l] + c * blk.y[i][l];
+      pz += blk.z[i][l];
+    }
+    blk.pca[0][l] = px * NInv;
+    blk.pca[1][l] = py * NInv;
+    blk.pca[2][l] = pz * NInv;
+    value_t chi2 = 0;
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      auto& res = blk.res[i];
+      res[0][l] = blk.x[i][l] - (c * blk.pca[0][l] + s * blk.pca[1][l]);
+      res[1][l] = blk.y[i][l] - (-s * blk.pca[0][l] + c * blk.pca[1][l]);
+      res[2][l] = blk.z[i][l] - blk.pca[2][l];
+      chi2 += res[0][l] * res[0][l] + res[1][l] * res[1][l] + res[2][l] * res[2][l];
+    }
+    blk.chi2[l] = chi2;
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::iterateLanes(LaneBlock& blk) const
+{
+  // single Newton-Rapson iteration for all active lanes, see DCAFitterN::minimizeChi2
+  const bool noErr = mUseAbsDCA;
+  for (int l = 0; l < NLanes; l++) {
+    const bool active = blk.status[l] == Active;
+    // chi2 1st and 2nd derivatives over X params of the tracks
+    value_t dchi[N], d2chi[N][N];
+    for (int i = N; i--;) {
+      dchi[i] = 0;
+      for (int j = N; j--;) {
+        const auto& dr = blk.dr1[j][i];
+        value_t cid0 = noErr ? dr[0][l] : blk.sxx[j][l] * dr[0][l];
+        value_t cid1 = noErr ? dr[1][l] : blk.syy[j][l] * dr[1][l] + blk.syz[j][l] * dr[2][l];
+        value_t cid2 = noErr ? dr[2][l] : blk.syz[j][l] * dr[1][l] + blk.szz[j][l] * dr[2][l];
+        dchi[i] += blk.res[j][0][l] * cid0 + blk.res[j][1][l] * cid1 + blk.res[j][2][l] * cid2;
+      }
+      for (int j = i + 1; j--;) { // symmetric matrix
+        value_t d2 = 0;
+        for (int k = N; k--;) {
+          const auto &dri = blk.dr1[k][i], &drj = blk.dr1[k][j];
+          value_t cid0 = noErr ? dri[0][l] : blk.sxx[k][l] * dri[0][l];
+          value_t cid1 = noErr ? dri[1][l] : blk.syy[k][l] * dri[1][l] + blk.syz[k][l] * dri[2][l];
+          value_t cid2 = noErr ? dri[2][l] : blk.syz[k][l] * dri[1][l] + blk.szz[k][l] * dri[2][l];
+          d2 += drj[0][l] * cid0 + drj[1][l] * cid1 + drj[2][l] * cid2;
+        }
+        // residual times its 2nd derivative: for the weighted case the residual of the track j, for abs. distance one of the track i
+        int k = noErr ? i : j;
+        const auto& dr2 = blk.dr2[k][j];
+        const auto& res = blk.res[k];
+        if (noErr) {
+          d2 += res[0][l] * dr2[0][l] + res[1][l] * dr2[1][l] + res[2][l] * dr2[2][l];
+        } else {
+          d2 += res[0][l] * blk.sxx[k][l] * dr2[0][l] + res[1][l] * (blk.syy[k][l] * dr2[1][l] + blk.syz[k][l] * dr2[2][l]) +
+                res[2][l] * (blk.syz[k][l] * dr2[1][l] + blk.szz[k][l] * dr2[2][l]);
+        }
+        d2chi[i][j] = d2chi[j][i] = d2;
+      }
+    }
+    // corrections = - dchi2/d{x0,x1} * [ d^2chi2/d{x0,x1}^2 ]^-1
+    value_t det = d2chi[0][0] * d2chi[1][1] - d2chi[1][0] * d2chi[1][0];
+    bool failed = det == 0;
+    value_t detI = failed ? value_t(0) : value_t(1) / det;
+    value_t dx[N] = {(d2chi[1][1] * dchi[0] - d2chi[1][0] * dchi[1]) * detI, (d2chi[0][0] * dchi[1] - d2chi[1][0] * dchi[0]) * detI};
+    value_t x[N], y[N], z[N];
+    for (int i = N; i--;) {
+      value_t dx2h = 0.5 * dx[i] * dx[i];
+      x[i] = blk.x[i][l] - dx[i];
+      y[i] = blk.y[i][l] - (blk.dydx[i][l] * dx[i] - dx2h * blk.d2ydx2[i][l]);
+      z[i] = blk.z[i][l] - (blk.dzdx[i][l] * dx[i] - dx2h * blk.d2zdx2[i][l]);
+    }
+    // updated PCA
+    value_t pca[3];
+    if (noErr) {
+      pca[0] = pca[1] = pca[2] = 0;
+      for (int i = N; i--;) {
+        value_t c = blk.c[i][l], s = blk.s[i][l];
+        pca[0] += c * x[i] - s * y[i];
+        pca[1] += s * x[i] + c * y[i];
+        pca[2] += z[i];
+      }
+      for (int k = 0; k < 3; k++) {
+        pca[k] *= NInv;
+      }
+    } else {
+      for (int k = 0; k < 3; k++) {
+        pca[k] = 0;
+        for (int i = N; i--;) {
+          pca[k] += blk.tcf[i][3 * k][l] * x[i] + blk.tcf[i][3 * k + 1][l] * y[i] + blk.tcf[i][3 * k + 2][l] * z[i];
+        }
+      }
+    }
+    // check if the PCA is closer to the seeding XY point being tested or to alternative seed
+    value_t dxCur = pca[0] - blk.curX[l], dyCur = pca[1] - blk.curY[l], dxAlt = pca[0] - blk.altX[l], dyAlt = pca[1] - blk.altY[l];
+    bool toAlt = blk.useAlt[l] && (dxCur * dxCur + dyCur * dyCur > dxAlt * dxAlt + dyAlt * dyAlt);
+    // updated residuals and chi2
+    value_t res[N][3], chi2 = 0;
+    for (int i = N; i--;) {
+      value_t c = blk.c[i][l], s = blk.s[i][l];
+      res[i][0] = x[i] - (c * pca[0] + s * pca[1]);
+      res[i][1] = y[i] - (-s * pca[0] + c * pca[1]);
+      res[i][2] = z[i] - pca[2];
+      chi2 += noErr ? res[i][0] * res[i][0] + res[i][1] * res[i][1] + res[i][2] * res[i][2]
+                    : res[i][0] * res[i][0] * blk.sxx[i][l] + res[i][1] * res[i][1] * blk.syy[i][l] + res[i][2] * res[i][2] * blk.szz[i][l] + 2. * res[i][1] * res[i][2] * blk.syz[i][l];
+    }
+    float chi2Upd = chi2;
+    bool converged = std::max(std::abs(dx[0]), std::abs(dx[1])) < mMinParamChange || chi2Upd > blk.chi2[l] * mMinRelChi2Change;
+    // store the state of active lanes
+    bool update = active && !failed && !toAlt;
+    for (int i = N; i--;) {
+      blk.x[i][l] = update ? x[i] : blk.x[i][l];
+      blk.y[i][l] = update ? y[i] : blk.y[i][l];
+      blk.z[i][l] = update ? z[i] : blk.z[i][l];
+      for (int k = 0; k < 3; k++) {
+        blk.res[i][k][l] = update ? res[i][k] : blk.res[i][k][l];
+      }
+    }
+    for (int k = 0; k < 3; k++) {
+      blk.pca[k][l] = active && !failed ? pca[k] : blk.pca[k][l];
+    }
+    blk.chi2[l] = update ? chi2Upd : blk.chi2[l];
+    blk.nIter[l] += update && !converged;
+    int status = failed ? Failed : (toAlt ? FailedAlt : ((converged || blk.nIter[l] >= mMaxIter) ? Converged : Active));
+    blk.status[l] = active ? status : blk.status[l];
+  }
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+bool DCAFitter2Batch<value_T, NLanes>::propagateTracksToVertex(Hypothesis& h)
+{
+  // propagate tracks to the PCA
+  if (h.propDone) {
+    return true;
+  }
+  for (int i = N; i--;) {
+    if (mUseAbsDCA) {
+      h.tracks[i] = *mPairs[h.pairID][i]; // fetch the track again, as it was propagated w/o errors
+    }
+    auto x = h.c[i] * h.pca[0] + h.s[i] * h.pca[1]; // X of PCA in the track frame
+    if (!h.tracks[i].propagateTo(x, mBz)) {
+      return false;
+    }
+  }
+  h.propDone = true;
+  return true;
+}
+
+//___________________________________________________________________
+template <typename value_T, int NLanes>
+void DCAFitter2Batch<value_T, NLanes>::print() const
+{
+  LOG(info) << "Batched 2-prong vertex fitter with " << NLanes << " lanes of " << sizeof(value_t) * 8 << " bits in "
+            << (mUseAbsDCA ? "abs." : "weighted") << " distance minimization mode";
+  LOG(info) << "Bz: " << mBz << " MaxIter: " << mMaxIter << " MaxChi2: " << mMaxChi2;
+  LOG(info) << "Stopping condition: Max.param change < " << mMinParamChange << " Rel.Chi2 change > " << mMinRelChi2Change;
+  LOG(info) << "Discard candidates for : Rvtx > " << getMaxR() << " DZ between tracks > " << mMaxDZIni;
+}
+
+} // namespace vertexing
+} // namespace o2
+#endif // _ALICEO2_DCA_FITTER2_BATCH_
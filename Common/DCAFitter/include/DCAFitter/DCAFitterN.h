@@ -197,6 +197,7 @@ class DCAFitterN
   float getMaxDXYIni() const { return mMaxDXYIni; }
   float getMaxChi2() const { return mMaxChi2; }
   float getMinParamChange() const { return mMinParamChange; }
+  float getMinRelChi2Change() const { return mMinRelChi2Change; }
   float getBz() const { return mBz; }
   float getMaxDistance2ToMerge() const { return mMaxDist2ToMergeSeeds; }
   bool getUseAbsDCA() const { return mUseAbsDCA; }
@@ -208,6 +209,7 @@ class DCAFitterN
   float getMaxSnp() const { return mMaxSnp; }
   float getMasStep() const { return mMaxStep; }
   float getMinXSeed() const { return mMinXSeed; }
+  bool getCollinear() const { return mIsCollinear; }
 
   template <class... Tr>
   int process(const Tr&... args);
@@ -0,0 +1,106 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief throughput of the scalar DCAFitterN<2> vs batched DCAFitter2Batch on V0-like track pairs
+// Pairs are made of 2 opposite sign tracks originating from a common vertex at R<40 cm, smeared within their errors
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include <array>
+#include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitter2Batch.h"
+
+using namespace o2::vertexing;
+using Track = o2::track::TrackParCov;
+
+constexpr float Bz = 5.;
+constexpr int NPairs = 10000;
+
+std::vector<std::array<Track, 2>> createPairs(int n)
+{
+  const float errYZ = 1e-2, errSlp = 1e-3, errQPT = 2e-2;
+  std::array<float, 15> covm = {
+    errYZ * errYZ,
+    0., errYZ * errYZ,
+    0, 0., errSlp * errSlp,
+    0., 0., 0., errSlp * errSlp,
+    0., 0., 0., 0., errQPT * errQPT};
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> flat(0., 1.);
+  std::normal_distribution<float> gaus(0., 1.);
+  std::vector<std::array<Track, 2>> pairs;
+  pairs.reserve(n);
+  while (int(pairs.size()) < n) {
+    float rdec = 1. + 39. * flat(gen), phiV = o2::constants::math::TwoPI * flat(gen);
+    float xv = rdec * std::cos(phiV), yv = rdec * std::sin(phiV), zv = 20. * (flat(gen) - 0.5);
+    std::array<Track, 2> trcs;
+    for (int i = 0; i < 2; i++) {
+      float phi = phiV + 0.5 * (flat(gen) - 0.5), s, c, x;
+      std::array<float, 5> params;
+      o2::math_utils::sincos(phi, s, c);
+      o2::math_utils::rotateZInv(xv, yv, x, params[0], s, c);
+      params[0] += gaus(gen) * errYZ;
+      params[1] = zv + gaus(gen) * errYZ;
+      params[2] = gaus(gen) * errSlp;
+      params[3] = 0.8 * (flat(gen) - 0.5) + gaus(gen) * errSlp;
+      params[4] = (i ? -1. : 1.) / (0.2 + 2. * flat(gen));
+      covm[14] = errQPT * errQPT * params[4] * params[4];
+      trcs[i] = Track(x, phi, params, covm);
+      trcs[i].propagateTo(x + 5. + 10. * flat(gen), Bz); // move away from the vertex
+    }
+    pairs.push_back(trcs);
+  }
+  return pairs;
+}
+
+// state.range: 0 - abs. DCA minimization flag
+static void BM_DCAFitter2Scalar(benchmark::State& state)
+{
+  auto pairs = createPairs(NPairs);
+  DCAFitterN<2> ft;
+  ft.setBz(Bz);
+  ft.setUseAbsDCA(state.range(0));
+  size_t nCand = 0;
+  for (auto _ : state) {
+    for (const auto& trcs : pairs) {
+      nCand += ft.process(trcs[0], trcs[1]);
+    }
+  }
+  benchmark::DoNotOptimize(nCand);
+  state.SetItemsProcessed(state.iterations() * NPairs);
+}
+
+// state.range: 0 - abs. DCA minimization flag
+template <typename T, int NLanes>
+static void BM_DCAFitter2Batch(benchmark::State& state)
+{
+  auto pairs = createPairs(NPairs);
+  DCAFitter2Batch<T, NLanes> ft(Bz, state.range(0), true);
+  size_t nCand = 0;
+  for (auto _ : state) {
+    ft.clear();
+    for (const auto& trcs : pairs) {
+      ft.addPair(trcs[0], trcs[1]);
+    }
+    nCand += ft.process();
+  }
+  benchmark::DoNotOptimize(nCand);
+  state.SetItemsProcessed(state.iterations() * NPairs);
+}
+
+BENCHMARK(BM_DCAFitter2Scalar)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, double, 4)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, double, 8)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, float, 8)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_DCAFitter2Batch, float, 16)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
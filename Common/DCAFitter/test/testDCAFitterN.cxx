@@ -15,6 +15,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitter2Batch.h"
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TRandom.h>
 #include <TGenPhaseSpace.h>
@@ -552,5 +553,79 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+// compare the batched fitter with value type T to the scalar one, allowing PCA deviation maxDist2 and track X deviation maxDX
+template <typename T>
+void checkDCAFitter2BatchVsScalar(float maxDist2, float maxDX, float maxMismatchFrac)
+{
+  constexpr int NTest = 5000;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<int> forceQ{1, 1};
+  std::vector<std::vector<o2::track::TrackParCov>> pairs(NTest);
+  Vec3D vtxGen;
+  double bz = 5.0;
+  for (auto& trcs : pairs) {
+    generate(vtxGen, trcs, bz, genPHS, k0, k0dec, forceQ);
+  }
+
+  o2::vertexing::DCAFitterN<2> ft;
+  ft.setBz(bz);
+  o2::vertexing::DCAFitter2Batch<T> ftb;
+
+  for (int absDCA = 0; absDCA < 2; absDCA++) {
+    ft.setUseAbsDCA(absDCA);
+    BOOST_CHECK(ftb.configureFrom(ft));
+    ftb.clear();
+    for (const auto& trcs : pairs) {
+      ftb.addPair(trcs[0], trcs[1]);
+    }
+    TStopwatch swS, swB;
+    swB.Start();
+    ftb.process();
+    swB.Stop();
+    int nDiffCand = 0, nDiffPCA = 0, nFound = 0;
+    swS.Start();
+    for (int ip = 0; ip < NTest; ip++) {
+      int nc = ft.process(pairs[ip][0], pairs[ip][1]);
+      if (nc != ftb.getNCandidates(ip)) {
+        nDiffCand++;
+        continue;
+      }
+      nFound += nc > 0;
+      for (int ic = 0; ic < nc; ic++) {
+        const auto& pca = ft.getPCACandidate(ic);
+        auto pcab = ftb.getPCACandidatePos(ip, ic);
+        float dst2 = 0;
+        for (int k = 0; k < 3; k++) {
+          dst2 += (pca[k] - pcab[k]) * (pca[k] - pcab[k]);
+        }
+        if (dst2 > maxDist2 || std::abs(ft.getTrack(0, ic).getX() - ftb.getTrack(ip, 0, ic).getX()) > maxDX) {
+          nDiffPCA++;
+        }
+      }
+    }
+    swS.Stop();
+    LOG(info) << "2-prongs in " << (absDCA ? "abs." : "wgh.") << " dist mode, batched<" << (sizeof(T) == sizeof(float) ? "float" : "double") << "> vs scalar fitter: eff= " << float(nFound) / NTest
+              << " N.cand. mismatches: " << nDiffCand << " PCA mismatches: " << nDiffPCA
+              << " CPU time batched: " << swB.CpuTime() << " scalar: " << swS.CpuTime();
+    BOOST_CHECK(nFound > 0.99 * NTest);
+    BOOST_CHECK(nDiffCand < maxMismatchFrac * NTest);
+    BOOST_CHECK(nDiffPCA < maxMismatchFrac * NTest);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DCAFitter2BatchVsScalar)
+{
+  checkDCAFitter2BatchVsScalar<double>(1e-8, 1e-4, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE(DCAFitter2BatchFloatVsScalar)
+{
+  // single precision lanes may converge in a different number of iterations: allow deviations within the convergence criterion
+  checkDCAFitter2BatchVsScalar<float>(1e-4, 2e-3, 0.01);
+}
+
 } // namespace vertexing
 } // namespace o2
@@ -114,6 +114,10 @@ class MagneticField : public FairField
   /// Main interface from TVirtualMagField used in simulation
   void Field(const Double_t* __restrict__ point, Double_t* __restrict__ bField) override;
 
+  /// Method to calculate the field at np points, point and bField are stored as x0,y0,z0,x1,...
+  /// Successive points of a track reuse the field map segment found for the previous one
+  void Field(int np, const Double_t* __restrict__ point, Double_t* __restrict__ bField);
+
   void field(const math_utils::Point3D<float> xyz, float bxyz[3])
   {
     double xyzd[3] = {xyz.X(), xyz.Y(), xyz.Z()}, bxyzd[3] = {0};
@@ -210,6 +210,10 @@ class MagneticWrapperChebyshev : public TNamed
   /// it gets it at closest valid point
   virtual void Field(const Double_t* xyz, Double_t* b) const;
 
+  /// Computes field in cartesian coordinates for np points, xyz and b are stored as x0,y0,z0,x1,...
+  /// Consecutive points of a track mostly fall in the same segment, which is then found w/o the full search
+  void Field(int np, const Double_t* xyz, Double_t* b) const;
+
   /// Computes Bz for the point in cartesian coordinates. If point is outside of the parameterized region
   /// it gets it at closest valid point
   Double_t getBz(const Double_t* xyz) const;
@@ -326,6 +330,9 @@ class MagneticWrapperChebyshev : public TNamed
   Double_t fieldCylindricalSolenoidBz(const Double_t* rphiz) const;
 
  private:
+  /// Assigns new ID to the segment tables, invalidating the segments cached by the threads for the old ones
+  void resetSegmentCache();
+
   Int_t mNumberOfParameterizationSolenoid;  ///< Total number of parameterization pieces for solenoid
   Int_t mNumberOfDistinctZSegmentsSolenoid; ///< number of distinct Z segments in Solenoid
   Int_t mNumberOfDistinctPSegmentsSolenoid; ///< number of distinct P segments in Solenoid
@@ -413,6 +420,7 @@ class MagneticWrapperChebyshev : public TNamed
   Float_t mMinDipoleZ;                ///< Min Z of Dipole parameterization
   Float_t mMaxDipoleZ;                ///< Max Z of Dipole parameterization
   TObjArray* mParameterizationDipole; ///< Parameterization pieces for Dipole field
+  ULong64_t mSegmentCacheID = 0;      //! ID of the segment tables, used to validate the per-thread last found segment
 
   ClassDefOverride(o2::field::MagneticWrapperChebyshev,
                    2) // Wrapper class for the set of Chebishev parameterizations of Alice mag.field
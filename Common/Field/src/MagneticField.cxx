@@ -286,6 +286,13 @@ void MagneticField::Field(const Double_t* __restrict__ xyz, Double_t* __restrict
   }
 }
 
+void MagneticField::Field(int np, const Double_t* __restrict__ xyz, Double_t* __restrict__ b)
+{
+  for (int i = 0; i < np; i++) {
+    MagneticField::Field(xyz + 3 * i, b + 3 * i);
+  }
+}
+
 Double_t MagneticField::getBz(const Double_t* xyz) const
 {
   /*
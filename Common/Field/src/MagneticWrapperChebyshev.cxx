@@ -17,6 +17,7 @@
 #include <TArrayF.h>    // for TArrayF
 #include <TArrayI.h>    // for TArrayI
 #include <TSystem.h>    // for TSystem, gSystem
+#include <atomic>       // for atomic
 #include <cstdio>       // for printf, fprintf, fclose, fopen, FILE
 #include <cstring>      // for memcpy
 #include <fairlogger/Logger.h> // for FairLogger
@@ -31,6 +32,48 @@ using namespace o2::math_utils;
 
 ClassImp(MagneticWrapperChebyshev);
 
+namespace
+{
+/// Indices of the segment found by the last search of the thread
+struct SegmentCache {
+  ULong64_t tableID = 0; ///< ID of the segment tables the indices refer to
+  int zid = 0;           ///< Z segment
+  int pid = 0;           ///< 2nd coordinate segment
+  int rid = 0;           ///< 1st coordinate segment
+};
+
+thread_local SegmentCache sSolenoidSegment;
+thread_local SegmentCache sDipoleSegment;
+std::atomic<ULong64_t> sSegmentTableCounter{0};
+
+/// Checks if the full segment search for the point pos (in r,p,z or x,y,z) would give the cached segment
+inline bool isInCachedSegment(const SegmentCache& cache, ULong64_t tableID, const Double_t* pos, int nZ,
+                              const Float_t* coordZ, const Float_t* coordP, const Int_t* begP, const Int_t* nP,
+                              const Float_t* coordR, const Int_t* begR, const Int_t* nR)
+{
+  if (cache.tableID != tableID) {
+    return false;
+  }
+  int zid = cache.zid;
+  Float_t z = pos[2];
+  if (!(coordZ[zid] <= z) || (zid + 1 < nZ && !(z < coordZ[zid + 1]))) {
+    return false;
+  }
+  if (zid && pos[2] - coordZ[zid] < 3.e-5) { // the search might have to recheck the previous Z bin
+    return false;
+  }
+  int pid = cache.pid, ip = pid - begP[zid];
+  if ((ip && !(pos[1] >= coordP[pid])) || (ip + 1 < nP[zid] && !(pos[1] < coordP[pid + 1]))) {
+    return false;
+  }
+  int rid = cache.rid, ir = rid - begR[pid];
+  if ((ir && !(pos[0] >= coordR[rid])) || (ir + 1 < nR[pid] && !(pos[0] < coordR[rid + 1]))) {
+    return false;
+  }
+  return true;
+}
+} // namespace
+
 MagneticWrapperChebyshev::MagneticWrapperChebyshev()
   : mNumberOfParameterizationSolenoid(0),
     mNumberOfDistinctZSegmentsSolenoid(0),
@@ -96,6 +139,7 @@ MagneticWrapperChebyshev::MagneticWrapperChebyshev()
     mMaxDipoleZ(-1.e6),
     mParameterizationDipole(nullptr)
 {
+  resetSegmentCache();
 }
 
 MagneticWrapperChebyshev::MagneticWrapperChebyshev(const MagneticWrapperChebyshev& src)
@@ -414,6 +458,12 @@ void MagneticWrapperChebyshev::Clear(const Option_t*)
     mNumberOfDistinctXSegmentsDipole = 0;
   mMinDipoleZ = 1e6;
   mMaxDipoleZ = -1e6;
+  resetSegmentCache();
+}
+
+void MagneticWrapperChebyshev::resetSegmentCache()
+{
+  mSegmentCacheID = ++sSegmentTableCounter;
 }
 
 void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
@@ -445,6 +495,13 @@ void MagneticWrapperChebyshev::Field(const Double_t* xyz, Double_t* b) const
   par->Eval(xyz, b);
 }
 
+void MagneticWrapperChebyshev::Field(int np, const Double_t* xyz, Double_t* b) const
+{
+  for (int i = 0; i < np; i++) {
+    MagneticWrapperChebyshev::Field(xyz + 3 * i, b + 3 * i);
+  }
+}
+
 Double_t MagneticWrapperChebyshev::getBz(const Double_t* xyz) const
 {
   Double_t rphiz[3];
@@ -513,6 +570,12 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
   if (!mNumberOfParameterizationDipole) {
     return -1;
   }
+  if (isInCachedSegment(sDipoleSegment, mSegmentCacheID, xyz, mNumberOfDistinctZSegmentsDipole,
+                        mCoordinatesSegmentsZDipole, mCoordinatesSegmentsYDipole, mBeginningOfSegmentsYDipole,
+                        mNumberOfSegmentsYDipole, mCoordinatesSegmentsXDipole, mBeginningOfSegmentsXDipole,
+                        mNumberOfSegmentsXDipole)) {
+    return mSegmentIdDipole[sDipoleSegment.rid];
+  }
   int xid, yid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsDipole, mCoordinatesSegmentsZDipole,
                                           (Float_t)xyz[2]); // find zsegment
 
@@ -551,6 +614,7 @@ Int_t MagneticWrapperChebyshev::findDipoleSegment(const Double_t* xyz) const
     }
     break;
   }
+  sDipoleSegment = {mSegmentCacheID, zid, yid, xid};
   return mSegmentIdDipole[xid];
 }
 
@@ -559,6 +623,12 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
   if (!mNumberOfParameterizationSolenoid) {
     return -1;
   }
+  if (isInCachedSegment(sSolenoidSegment, mSegmentCacheID, rpz, mNumberOfDistinctZSegmentsSolenoid,
+                        mCoordinatesSegmentsZSolenoid, mCoordinatesSegmentsPSolenoid, mBeginningOfSegmentsPSolenoid,
+                        mNumberOfSegmentsPSolenoid, mCoordinatesSegmentsRSolenoid, mBeginningOfSegmentsRSolenoid,
+                        mNumberOfRSegmentsSolenoid)) {
+    return mSegmentIdSolenoid[sSolenoidSegment.rid];
+  }
   int rid, pid, zid = TMath::BinarySearch(mNumberOfDistinctZSegmentsSolenoid, mCoordinatesSegmentsZSolenoid,
                                           (Float_t)rpz[2]); // find zsegment
 
@@ -595,6 +665,7 @@ Int_t MagneticWrapperChebyshev::findSolenoidSegment(const Double_t* rpz) const
     }
     break;
   }
+  sSolenoidSegment = {mSegmentCacheID, zid, pid, rid};
   return mSegmentIdSolenoid[rid];
 }
 
@@ -924,6 +995,7 @@ void MagneticWrapperChebyshev::buildTableSolenoid()
              &mCoordinatesSegmentsZSolenoid, &mCoordinatesSegmentsPSolenoid, &mCoordinatesSegmentsRSolenoid,
              &mBeginningOfSegmentsPSolenoid, &mNumberOfSegmentsPSolenoid, &mBeginningOfSegmentsRSolenoid,
              &mNumberOfRSegmentsSolenoid, &mSegmentIdSolenoid);
+  resetSegmentCache();
 }
 
 void MagneticWrapperChebyshev::buildTableDipole()
@@ -933,6 +1005,7 @@ void MagneticWrapperChebyshev::buildTableDipole()
              &mCoordinatesSegmentsZDipole, &mCoordinatesSegmentsYDipole, &mCoordinatesSegmentsXDipole,
              &mBeginningOfSegmentsYDipole, &mNumberOfSegmentsYDipole, &mBeginningOfSegmentsXDipole,
              &mNumberOfSegmentsXDipole, &mSegmentIdDipole);
+  resetSegmentCache();
 }
 
 void MagneticWrapperChebyshev::buildTableTPCIntegral()
@@ -1094,6 +1167,7 @@ void MagneticWrapperChebyshev::resetDipole()
     mNumberOfDistinctYSegmentsDipole = 0;
   mMinDipoleZ = 1e6;
   mMaxDipoleZ = -1e6;
+  resetSegmentCache();
 }
 
 void MagneticWrapperChebyshev::resetSolenoid()
@@ -1123,6 +1197,7 @@ void MagneticWrapperChebyshev::resetSolenoid()
   mMinZSolenoid = 1e6;
   mMaxZSolenoid = -1e6;
   mMaxRadiusSolenoid = 0;
+  resetSegmentCache();
 }
 
 void MagneticWrapperChebyshev::resetTPCIntegral()
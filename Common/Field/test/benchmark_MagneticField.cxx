@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief time needed to query the measured field map for points along helical tracks (successive points
+// mostly in the same parameterization segment) vs randomly distributed points, point by point or in batch.
+// The field maps are taken from $O2_ROOT/share/Common/maps, as for the MagneticField test.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Field/MagneticField.h"
+#include "Field/MagneticWrapperChebyshev.h"
+#include <TMath.h>
+
+using namespace o2::field;
+
+std::vector<double> createPoints(bool tracks, int np)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::vector<double> xyz(np * 3);
+  const int nstep = 500;
+  double radius = 0, phi0 = 0, tgl = 0, sgn = 1;
+  for (int ip = 0; ip < np; ip++) {
+    double* p = &xyz[ip * 3];
+    if (tracks) {
+      int is = ip % nstep;
+      if (!is) {
+        radius = 100. + uniform(gen) * 2000.;
+        phi0 = uniform(gen) * TMath::Pi() * 2;
+        tgl = (uniform(gen) - 0.5) * 1.5;
+        sgn = -sgn;
+      }
+      p[0] = radius * (TMath::Sin(phi0 + sgn * is / radius) - TMath::Sin(phi0)) * sgn;
+      p[1] = -radius * (TMath::Cos(phi0 + sgn * is / radius) - TMath::Cos(phi0)) * sgn;
+      p[2] = is * tgl;
+    } else {
+      double r = uniform(gen) * 400., phi = uniform(gen) * TMath::Pi() * 2;
+      p[0] = r * TMath::Cos(phi);
+      p[1] = r * TMath::Sin(phi);
+      p[2] = (uniform(gen) - 0.5) * 500.;
+    }
+  }
+  return xyz;
+}
+
+// state.range(0): 1 - points along tracks, 0 - random points
+// state.range(1): 1 - batch query, 0 - point by point
+static void BM_FieldMap(benchmark::State& state)
+{
+  auto fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., MagFieldParam::k5kG);
+  const MagneticWrapperChebyshev* map = fld->getMeasuredMap();
+  const int np = 100000;
+  auto xyz = createPoints(state.range(0), np);
+  std::vector<double> b(xyz.size());
+  const bool batch = state.range(1);
+  for (auto _ : state) {
+    if (batch) {
+      map->Field(np, xyz.data(), b.data());
+    } else {
+      for (int ip = 0; ip < np; ip++) {
+        map->Field(&xyz[ip * 3], &b[ip * 3]);
+      }
+    }
+    benchmark::DoNotOptimize(b.data());
+  }
+  state.SetItemsProcessed(state.iterations() * np);
+}
+
+BENCHMARK(BM_FieldMap)->Args({0, 0})->Args({0, 1})->Args({1, 0})->Args({1, 1})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,7 @@
 #include "Field/MagneticField.h"
 #include "Field/MagFieldFast.h"
 #include <memory>
+#include <vector>
 #include <fairlogger/Logger.h> // for FairLogger
 #include <TStopwatch.h>
 #include <TRandom.h>
@@ -98,3 +99,52 @@ BOOST_AUTO_TEST_CASE(MagneticField_test)
     BOOST_CHECK(TMath::Abs(rms[i] / nomBz) < 1.e-3);
   }
 }
+
+BOOST_AUTO_TEST_CASE(MagneticField_batch_test)
+{
+  // field along track-like sequences of points, evaluated in batch (reusing the segment found for the
+  // previous point) must be identical to the one obtained with the full segment search for every point
+  std::unique_ptr<MagneticField> fld = std::make_unique<MagneticField>("Maps", "Maps", 1., 1., o2::field::MagFieldParam::k5kG);
+  const MagneticWrapperChebyshev* map = fld->getMeasuredMap();
+  BOOST_REQUIRE(map != nullptr);
+  MagneticWrapperChebyshev mapCopy(*map);
+
+  const int ntrk = 100, nstep = 500;
+  std::vector<double> xyz(ntrk * nstep * 3), bRef(xyz.size()), bBatch(xyz.size()), bFld(xyz.size());
+  float rnd[3];
+  for (int itr = 0; itr < ntrk; itr++) {
+    gRandom->RndmArray(3, rnd);
+    double radius = 100. + rnd[0] * 2000., phi0 = rnd[1] * TMath::Pi() * 2, tgl = (rnd[2] - 0.5) * 1.5;
+    double sgn = itr % 2 ? 1. : -1.;
+    for (int is = 0; is < nstep; is++) {
+      double s = is * 1.;
+      double* p = &xyz[(itr * nstep + is) * 3];
+      p[0] = radius * (TMath::Sin(phi0 + sgn * s / radius) - TMath::Sin(phi0)) * sgn;
+      p[1] = -radius * (TMath::Cos(phi0 + sgn * s / radius) - TMath::Cos(phi0)) * sgn;
+      p[2] = s * tgl;
+    }
+  }
+  // reference: alternating between 2 maps invalidates the per-thread segment cache at every call
+  double bDummy[3];
+  for (int ip = 0; ip < ntrk * nstep; ip++) {
+    map->Field(&xyz[ip * 3], &bRef[ip * 3]);
+    mapCopy.Field(&xyz[ip * 3], bDummy);
+  }
+  map->Field(ntrk * nstep, xyz.data(), bBatch.data());
+  int nDiff = 0;
+  for (size_t i = 0; i < xyz.size(); i++) {
+    nDiff += bBatch[i] != bRef[i];
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+
+  fld->Field(ntrk * nstep, xyz.data(), bFld.data());
+  nDiff = 0;
+  for (int ip = 0; ip < ntrk * nstep; ip++) {
+    double b[3];
+    fld->Field(&xyz[ip * 3], b);
+    for (int i = 0; i < 3; i++) {
+      nDiff += bFld[ip * 3 + i] != b[i];
+    }
+  }
+  BOOST_CHECK_EQUAL(nDiff, 0);
+}
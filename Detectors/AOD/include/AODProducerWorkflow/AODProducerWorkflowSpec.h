@@ -31,6 +31,7 @@
 #include "ZDCBase/Constants.h"
 #include "GlobalTracking/MatchGlobalFwd.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <vector>
@@ -42,6 +43,41 @@ using DataRequest = o2::globaltracking::DataRequest;
 
 namespace o2::aodproducer
 {
+/// Flat sorted container of the globalBCs of a timeframe.
+/// The BCs are collected in arbitrary order, then sorted and made unique by finalize(),
+/// the bcID of the globalBC is its position in the container.
+class FlatBCMap
+{
+ public:
+  void clear() { mBCs.clear(); }
+  void reserve(size_t n) { mBCs.reserve(n); }
+  void add(uint64_t bc) { mBCs.push_back(bc); }
+
+  /// sort and remove duplicates, must be called after adding BCs and before the lookup
+  void finalize()
+  {
+    std::sort(mBCs.begin(), mBCs.end());
+    mBCs.erase(std::unique(mBCs.begin(), mBCs.end()), mBCs.end());
+  }
+
+  /// return bcID of the globalBC or -1 if it is not registered
+  int getID(uint64_t bc) const
+  {
+    auto it = std::lower_bound(mBCs.begin(), mBCs.end(), bc);
+    return (it != mBCs.end() && *it == bc) ? int(it - mBCs.begin()) : -1;
+  }
+
+  size_t size() const { return mBCs.size(); }
+  bool empty() const { return mBCs.empty(); }
+  uint64_t back() const { return mBCs.back(); }
+  auto begin() const { return mBCs.begin(); }
+  auto end() const { return mBCs.end(); }
+  std::vector<uint64_t> const& getBCs() const { return mBCs; }
+
+ private:
+  std::vector<uint64_t> mBCs; // sorted vector of unique globalBCs
+};
+
 /// A structure or container to organize bunch crossing data of a timeframe
 /// and to facilitate fast lookup and search within bunch crossings.
 class BunchCrossings
@@ -51,13 +87,11 @@ class BunchCrossings
   BunchCrossings() = default;
 
   /// initialize this container (to be ready for lookup/search queries)
-  void init(std::map<uint64_t, int> const& bcs)
+  void init(FlatBCMap const& bcs)
   {
     clear();
     // init the structures
-    for (auto& key : bcs) {
-      mBCTimeVector.emplace_back(key.first);
-    }
+    mBCTimeVector = bcs.getBCs();
     initTimeWindows();
   }
 
@@ -116,7 +150,6 @@ class BunchCrossings
   /// clear/reset this container
   void clear()
   {
-    mBCs.clear();
     mBCTimeVector.clear();
     mTimeWindows.clear();
   }
@@ -137,7 +170,6 @@ class BunchCrossings
   }
 
  private:
-  std::map<uint64_t, int> mBCs;
   std::vector<uint64_t> mBCTimeVector; // simple sorted vector of BC times
 
   /// initialize the internal acceleration structure
@@ -408,6 +440,15 @@ class AODProducerWorkflowDPL : public Task
     uint8_t tpcdEdxTot3R;
   };
 
+  // helper struct for barrel tracks processed before filling the tables
+  struct BarrelTrackInfo {
+    TrackExtraInfo extraInfo;
+    o2::track::TrackParCov trackPar; // track propagated to PV, if isProp
+    bool isProp = false;
+  };
+  std::vector<BarrelTrackInfo> mBarrelTracksInfo; // barrel tracks processed in parallel
+  std::vector<int> mBarrelTracksInfoID;           // entry in mBarrelTracksInfo for every track-vertex association index, -1 if not processed
+
   // helper struct for addToFwdTracksTable()
   struct FwdTrackInfo {
     uint8_t trackTypeId = 0;
@@ -473,11 +514,11 @@ class AODProducerWorkflowDPL : public Task
   void updateTimeDependentParams(ProcessingContext& pc);
 
   void addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
-                             const o2::globaltracking::RecoContainer& data, std::map<uint64_t, int>& bcsMap);
+                             const o2::globaltracking::RecoContainer& data, FlatBCMap& bcsMap);
   void createCTPReadout(const o2::globaltracking::RecoContainer& recoData, std::vector<o2::ctp::CTPDigit>& ctpDigits, ProcessingContext& pc);
   void collectBCs(const o2::globaltracking::RecoContainer& data,
                   const std::vector<o2::InteractionTimeRecord>& mcRecords,
-                  std::map<uint64_t, int>& bcsMap);
+                  FlatBCMap& bcsMap);
 
   template <typename TracksCursorType, typename TracksCovCursorType>
   void addToTracksTable(TracksCursorType& tracksCursor, TracksCovCursorType& tracksCovCursor,
@@ -492,14 +533,17 @@ class AODProducerWorkflowDPL : public Task
   template <typename mftTracksCursorType, typename AmbigMFTTracksCursorType>
   void addToMFTTracksTable(mftTracksCursorType& mftTracksCursor, AmbigMFTTracksCursorType& ambigMFTTracksCursor,
                            GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID,
-                           std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap);
+                           std::uint64_t collisionBC, const FlatBCMap& bcsMap);
 
   template <typename fwdTracksCursorType, typename fwdTracksCovCursorType, typename AmbigFwdTracksCursorType>
   void addToFwdTracksTable(fwdTracksCursorType& fwdTracksCursor, fwdTracksCovCursorType& fwdTracksCovCursor, AmbigFwdTracksCursorType& ambigFwdTracksCursor,
-                           GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap);
+                           GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC, const FlatBCMap& bcsMap);
 
-  TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
-  TrackQA processBarrelTrackQA(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
+  TrackExtraInfo processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap);
+  void fillBarrelTrackInfo(BarrelTrackInfo& info, int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap);
+  void prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                           const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap);
+  TrackQA processBarrelTrackQA(int collisionID, std::uint64_t collisionBC, GIndex trackIndex, const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap);
 
   bool propagateTrackToPV(o2::track::TrackParametrizationWithError<float>& trackPar, const o2::globaltracking::RecoContainer& data, int colID);
   void extrapolateToCalorimeters(TrackExtraInfo& extraInfoHolder, const o2::track::TrackPar& track);
@@ -527,7 +571,7 @@ class AODProducerWorkflowDPL : public Task
                                    FwdTracksCovCursorType& fwdTracksCovCursor,
                                    AmbigFwdTracksCursorType& ambigFwdTracksCursor,
                                    FwdTrkClsCursorType& fwdTrkClsCursor,
-                                   const std::map<uint64_t, int>& bcsMap);
+                                   const FlatBCMap& bcsMap);
 
   template <typename FwdTrkClsCursorType>
   void addClustersToFwdTrkClsTable(const o2::globaltracking::RecoContainer& recoData, FwdTrkClsCursorType& fwdTrkClsCursor, GIndex trackID, int fwdTrackId);
@@ -620,7 +664,7 @@ class AODProducerWorkflowDPL : public Task
                               const o2::globaltracking::RecoContainer& data,
                               int vertexId = -1);
 
-  std::uint64_t fillBCSlice(int (&slice)[2], double tmin, double tmax, const std::map<uint64_t, int>& bcsMap) const;
+  std::uint64_t fillBCSlice(int (&slice)[2], double tmin, double tmax, const FlatBCMap& bcsMap) const;
 
   // helper for tpc clusters
   void countTPCClusters(const o2::globaltracking::RecoContainer& data);
@@ -634,7 +678,7 @@ class AODProducerWorkflowDPL : public Task
 
   template <typename TCaloCursor, typename TCaloTRGCursor, typename TMCCaloLabelCursor>
   void fillCaloTable(TCaloCursor& caloCellCursor, TCaloTRGCursor& caloTRGCursor,
-                     TMCCaloLabelCursor& mcCaloCellLabelCursor, const std::map<uint64_t, int>& bcsMap,
+                     TMCCaloLabelCursor& mcCaloCellLabelCursor, const FlatBCMap& bcsMap,
                      const o2::globaltracking::RecoContainer& data);
 
   std::set<uint64_t> filterEMCALIncomplete(const gsl::span<const o2::emcal::TriggerRecord> triggers);
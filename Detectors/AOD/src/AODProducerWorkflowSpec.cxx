@@ -87,7 +87,9 @@
 #include "TString.h"
 #include <map>
 #include <numeric>
+#include <limits>
 #include <unordered_map>
+#include <unordered_set>
 #include <set>
 #include <string>
 #include <vector>
@@ -211,7 +213,7 @@ void AODProducerWorkflowDPL::createCTPReadout(const o2::globaltracking::RecoCont
 
 void AODProducerWorkflowDPL::collectBCs(const o2::globaltracking::RecoContainer& data,
                                         const std::vector<o2::InteractionTimeRecord>& mcRecords,
-                                        std::map<uint64_t, int>& bcsMap)
+                                        FlatBCMap& bcsMap)
 {
   const auto& primVertices = data.getPrimaryVertices();
   const auto& fddRecPoints = data.getFDDRecPoints();
@@ -223,66 +225,65 @@ void AODProducerWorkflowDPL::collectBCs(const o2::globaltracking::RecoContainer&
   const auto& ctpDigits = data.getCTPDigits();
   const auto& zdcBCRecData = data.getZDCBCRecData();
 
-  bcsMap[mStartIR.toLong()] = 1; // store the start of TF
+  bcsMap.clear();
+  bcsMap.reserve(1 + mcRecords.size() + fddRecPoints.size() + ft0RecPoints.size() + fv0RecPoints.size() + zdcBCRecData.size() + primVertices.size() +
+                 caloEMCCellsTRGR.size() + caloPHOSCellsTRGR.size() + cpvTRGR.size() + ctpDigits.size());
+  bcsMap.add(mStartIR.toLong()); // store the start of TF
 
   // collecting non-empty BCs and enumerating them
   for (auto& rec : mcRecords) {
     uint64_t globalBC = rec.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& fddRecPoint : fddRecPoints) {
     uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& ft0RecPoint : ft0RecPoints) {
     uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& fv0RecPoint : fv0RecPoints) {
     uint64_t globalBC = fv0RecPoint.getInteractionRecord().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& zdcRecData : zdcBCRecData) {
     uint64_t globalBC = zdcRecData.ir.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& vertex : primVertices) {
     auto& timeStamp = vertex.getTimeStamp();
     double tsTimeStamp = timeStamp.getTimeStamp() * 1E3; // mus to ns
     uint64_t globalBC = relativeTime_to_GlobalBC(tsTimeStamp);
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& emcaltrg : caloEMCCellsTRGR) {
     uint64_t globalBC = emcaltrg.getBCData().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& phostrg : caloPHOSCellsTRGR) {
     uint64_t globalBC = phostrg.getBCData().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& cpvtrg : cpvTRGR) {
     uint64_t globalBC = cpvtrg.getBCData().toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
   for (auto& ctpDigit : ctpDigits) {
     uint64_t globalBC = ctpDigit.intRecord.toLong();
-    bcsMap[globalBC] = 1;
+    bcsMap.add(globalBC);
   }
 
-  int bcID = 0;
-  for (auto& item : bcsMap) {
-    item.second = bcID;
-    bcID++;
-  }
+  bcsMap.finalize(); // sort and enumerate
 }
 
 template <typename TracksCursorType, typename TracksCovCursorType>
@@ -378,7 +379,7 @@ void AODProducerWorkflowDPL::addToTracksQATable(TracksQACursorType& tracksQACurs
 template <typename mftTracksCursorType, typename AmbigMFTTracksCursorType>
 void AODProducerWorkflowDPL::addToMFTTracksTable(mftTracksCursorType& mftTracksCursor, AmbigMFTTracksCursorType& ambigMFTTracksCursor,
                                                  GIndex trackID, const o2::globaltracking::RecoContainer& data, int collisionID,
-                                                 std::uint64_t collisionBC, const std::map<uint64_t, int>& bcsMap)
+                                                 std::uint64_t collisionBC, const FlatBCMap& bcsMap)
 {
   // mft tracks
   int bcSlice[2] = {-1, -1};
@@ -435,7 +436,7 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                                                          FwdTracksCovCursorType& fwdTracksCovCursor,
                                                          AmbigFwdTracksCursorType& ambigFwdTracksCursor,
                                                          FwdTrkClsCursorType& fwdTrkClsCursor,
-                                                         const std::map<uint64_t, int>& bcsMap)
+                                                         const FlatBCMap& bcsMap)
 {
   for (int src = GIndex::NSources; src--;) {
     if (!GIndex::isTrackSource(src)) {
@@ -477,7 +478,13 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           if (trackIndex.isAmbiguous() && mGIDToTableID.find(trackIndex) != mGIDToTableID.end()) { // was it already stored ?
             continue;
           }
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+          BarrelTrackInfo localInfo;
+          int infoID = mBarrelTracksInfoID.empty() ? -1 : mBarrelTracksInfoID[ti];
+          if (infoID < 0) { // was not processed in advance
+            fillBarrelTrackInfo(localInfo, collisionID, collisionBC, trackIndex, data, bcsMap);
+          }
+          auto& trackInfo = infoID < 0 ? localInfo : mBarrelTracksInfo[infoID];
+          auto& extraInfoHolder = trackInfo.extraInfo;
 
           float weight = 0;
           std::uniform_real_distribution<> distr(0., 1.);
@@ -498,17 +505,10 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
                          << " timeErr=" << extraInfoHolder.trackTimeRes << " BCSlice: " << extraInfoHolder.bcSlice[0] << ":" << extraInfoHolder.bcSlice[1];
             continue;
           }
-          const auto& trOrig = data.getTrackParam(trackIndex);
-          bool isProp = false;
-          if (mPropTracks && trOrig.getX() < mMinPropR && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end()) { // Do not propagate track assoc. to V0s
-            auto trackPar(trOrig);
-            isProp = propagateTrackToPV(trackPar, data, collisionID);
-            if (isProp) {
-              addToTracksTable(tracksCursor, tracksCovCursor, trackPar, collisionID, aod::track::Track);
-            }
-          }
-          if (!isProp) {
-            addToTracksTable(tracksCursor, tracksCovCursor, trOrig, collisionID, aod::track::TrackIU);
+          if (trackInfo.isProp) {
+            addToTracksTable(tracksCursor, tracksCovCursor, trackInfo.trackPar, collisionID, aod::track::Track);
+          } else {
+            addToTracksTable(tracksCursor, tracksCovCursor, data.getTrackParam(trackIndex), collisionID, aod::track::TrackIU);
           }
           addToTracksExtraTable(tracksExtraCursor, extraInfoHolder);
           // addToTracksQATable(tracksQACursor, trackQAInfoHolder);
@@ -582,7 +582,7 @@ template <typename FwdTracksCursorType, typename FwdTracksCovCursorType, typenam
 void AODProducerWorkflowDPL::addToFwdTracksTable(FwdTracksCursorType& fwdTracksCursor, FwdTracksCovCursorType& fwdTracksCovCursor,
                                                  AmbigFwdTracksCursorType& ambigFwdTracksCursor, GIndex trackID,
                                                  const o2::globaltracking::RecoContainer& data, int collisionID, std::uint64_t collisionBC,
-                                                 const std::map<uint64_t, int>& bcsMap)
+                                                 const FlatBCMap& bcsMap)
 {
   const auto& mchTracks = data.getMCHTracks();
   const auto& midTracks = data.getMIDTracks();
@@ -1555,7 +1555,7 @@ void AODProducerWorkflowDPL::addToCaloTable(TCaloHandler& caloHandler, TCaloCurs
 // fill calo related tables (cells and calotrigger table)
 template <typename TCaloCursor, typename TCaloTRGCursor, typename TMCCaloLabelCursor>
 void AODProducerWorkflowDPL::fillCaloTable(TCaloCursor& caloCellCursor, TCaloTRGCursor& caloTRGCursor,
-                                           TMCCaloLabelCursor& mcCaloCellLabelCursor, const std::map<uint64_t, int>& bcsMap,
+                                           TMCCaloLabelCursor& mcCaloCellLabelCursor, const FlatBCMap& bcsMap,
                                            const o2::globaltracking::RecoContainer& data)
 {
   // get calo information
@@ -1616,11 +1616,8 @@ void AODProducerWorkflowDPL::fillCaloTable(TCaloCursor& caloCellCursor, TCaloTRG
     uint64_t globalBC = std::get<0>(caloEvents[i]);
     int8_t caloType = std::get<1>(caloEvents[i]);
     int eventID = std::get<2>(caloEvents[i]);
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(globalBC);
+    if (bcID < 0) {
       LOG(warn) << "Error: could not find a corresponding BC ID for a calo point; globalBC = " << globalBC << ", caloType = " << (int)caloType;
     }
     if (caloType == 0) { // phos
@@ -1833,7 +1830,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     mcReader = std::make_unique<o2::steer::MCKinematicsReader>("collisioncontext.root");
   }
   mMCKineReader = mcReader.get(); // for use in different functions
-  std::map<uint64_t, int> bcsMap;
+  FlatBCMap bcsMap;
   collectBCs(recoData, mUseMC ? mcReader->getDigitizationContext()->getEventRecords() : std::vector<o2::InteractionTimeRecord>{}, bcsMap);
   if (!primVer2TRefs.empty()) { // if the vertexing was done, the last slot refers to orphan tracks
     addRefGlobalBCsForTOF(primVer2TRefs.back(), primVerGIs, recoData, bcsMap);
@@ -1864,11 +1861,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
       }
     }
     uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
     }
     fv0aCursor(bcID,
@@ -1883,11 +1877,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   zdcCursor.reserve(zdcBCRecData.size());
   for (auto zdcRecData : zdcBCRecData) {
     uint64_t bc = zdcRecData.ir.toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
     }
     int fe, ne, ft, nt, fi, ni;
@@ -1939,11 +1930,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     for (int iCol = 0; iCol < nMCCollisions; iCol++) {
       const auto time = mcRecords[iCol].getTimeOffsetWrtBC();
       auto globalBC = mcRecords[iCol].toLong();
-      auto item = bcsMap.find(globalBC);
-      int bcID = -1;
-      if (item != bcsMap.end()) {
-        bcID = item->second;
-      } else {
+      int bcID = bcsMap.getID(globalBC);
+      if (bcID < 0) {
         LOG(fatal) << "Error: could not find a corresponding BC ID "
                    << "for MC collision; BC = " << globalBC
                    << ", mc collision = " << iCol;
@@ -2000,11 +1988,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
     uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
     uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
     }
     fddCursor(bcID,
@@ -2040,11 +2025,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
     uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
     uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(bc);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
     }
     ft0Cursor(bcID,
@@ -2113,6 +2095,9 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
   }
 
+  // process barrel tracks of all collisions in parallel, the tables are filled sequentially below
+  prepareBarrelTracks(primVer2TRefs, primVerGIs, recoData, bcsMap);
+
   // filling unassigned tracks first
   // so that all unassigned tracks are stored in the beginning of the table together
   auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
@@ -2133,11 +2118,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     LOG(debug) << "global BC " << globalBC << " local BC " << localBC << " relative interaction time " << interactionTime;
     // collision timestamp in ns wrt the beginning of collision BC
     const float relInteractionTime = static_cast<float>(localBC * o2::constants::lhc::LHCBunchSpacingNS - interactionTime);
-    auto item = bcsMap.find(globalBC);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
+    int bcID = bcsMap.getID(globalBC);
+    if (bcID < 0) {
       LOG(fatal) << "Error: could not find a corresponding BC ID for a collision; BC = " << globalBC << ", collisionID = " << collisionID;
     }
     collisionsCursor(bcID,
@@ -2191,8 +2173,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   // filling BC table
   bcCursor.reserve(bcsMap.size());
-  for (auto& item : bcsMap) {
-    uint64_t bc = item.first;
+  for (auto bc : bcsMap) {
     std::pair<uint64_t, uint64_t> masks{0, 0};
     if (mInputSources[GID::CTP]) {
       auto bcClassPair = bcToClassMask.find(bc);
@@ -2214,11 +2195,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     cpvClustersCursor.reserve(cpvTrigRecs.size());
     for (auto& cpvEvent : cpvTrigRecs) {
       uint64_t bc = cpvEvent.getBCData().toLong();
-      auto item = bcsMap.find(bc);
-      int bcID = -1;
-      if (item != bcsMap.end()) {
-        bcID = item->second;
-      } else {
+      int bcID = bcsMap.getID(bc);
+      if (bcID < 0) {
         LOG(fatal) << "Error: could not find a corresponding BC ID for a CPV Trigger Record; BC = " << bc;
       }
       for (int iClu = cpvEvent.getFirstEntry(); iClu < cpvEvent.getFirstEntry() + cpvEvent.getNumberOfObjects(); iClu++) {
@@ -2264,6 +2242,8 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   }
 
   bcsMap.clear();
+  mBarrelTracksInfo.clear();
+  mBarrelTracksInfoID.clear();
   clearMCKeepStore(mToStore);
   mGIDToTableID.clear();
   mTableTrID = 0;
@@ -2372,7 +2352,7 @@ void AODProducerWorkflowDPL::cacheTriggers(const o2::globaltracking::RecoContain
 }
 
 AODProducerWorkflowDPL::TrackExtraInfo AODProducerWorkflowDPL::processBarrelTrack(int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
-                                                                                  const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+                                                                                  const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap)
 {
   TrackExtraInfo extraInfoHolder;
   if (collisionID < 0) {
@@ -2489,8 +2469,79 @@ AODProducerWorkflowDPL::TrackExtraInfo AODProducerWorkflowDPL::processBarrelTrac
   return extraInfoHolder;
 }
 
+void AODProducerWorkflowDPL::fillBarrelTrackInfo(BarrelTrackInfo& info, int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
+                                                 const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap)
+{
+  // process barrel track and, if requested, propagate it to the PV
+  info.extraInfo = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+  info.isProp = false;
+  if (!info.extraInfo.isTPConly && info.extraInfo.trackTimeRes < 0.f) { // will be rejected
+    return;
+  }
+  const auto& trOrig = data.getTrackParam(trackIndex);
+  if (mPropTracks && trOrig.getX() < mMinPropR && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end()) { // Do not propagate track assoc. to V0s
+    info.trackPar = trOrig;
+    info.isProp = propagateTrackToPV(info.trackPar, data, collisionID);
+  }
+}
+
+void AODProducerWorkflowDPL::prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& primVer2TRefs, const gsl::span<const GIndex>& GIndices,
+                                                 const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap)
+{
+  // Process barrel tracks in parallel before filling the tables, which is done sequentially by fillTrackTablesPerCollision
+  // using the results stored per track-vertex association index, so that the output does not depend on the number of threads.
+  // Since the ambiguous tracks are stored only once, they are processed only for their 1st occurrence in the filling order
+  // (orphan tracks first, then vertices), the rest will be processed on demand during the filling.
+  mBarrelTracksInfo.clear();
+  mBarrelTracksInfoID.clear();
+  if (mNThreads < 2 || primVer2TRefs.empty()) {
+    return; // tracks will be processed while filling the tables
+  }
+  struct BarrelTrackTask {
+    int entry;
+    int collisionID;
+    std::uint64_t collisionBC;
+  };
+  std::vector<BarrelTrackTask> tasks;
+  std::unordered_set<GIndex> ambiguous;
+  mBarrelTracksInfoID.resize(GIndices.size(), -1);
+  const auto& primVertices = data.getPrimaryVertices();
+  int nColl = primVer2TRefs.size() - 1; // last slot refers to orphan tracks
+  for (int collisionID = -1; collisionID < nColl; collisionID++) {
+    const auto& trackRef = primVer2TRefs[collisionID < 0 ? nColl : collisionID];
+    std::uint64_t collisionBC = collisionID < 0 ? std::uint64_t(-1) : relativeTime_to_GlobalBC(primVertices[collisionID].getTimeStamp().getTimeStamp() * 1E3);
+    for (int src = GIndex::NSources; src--;) {
+      if (!GIndex::isTrackSource(src) || !GIndex::includesSource(src, mInputSources) ||
+          src == GIndex::Source::MFT || src == GIndex::Source::MCH || src == GIndex::Source::MFTMCH || src == GIndex::Source::MCHMID) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        const auto& trackIndex = GIndices[ti];
+        if (trackIndex.isAmbiguous() && !ambiguous.insert(trackIndex).second) { // was already processed for other vertex
+          continue;
+        }
+        mBarrelTracksInfoID[ti] = tasks.size();
+        tasks.push_back({ti, collisionID, collisionBC});
+      }
+    }
+  }
+  int ntasks = tasks.size();
+  mBarrelTracksInfo.resize(ntasks);
+#ifdef WITH_OPENMP
+  int ngroup = std::min(50, std::max(1, ntasks / mNThreads));
+#pragma omp parallel for schedule(dynamic, ngroup) num_threads(mNThreads)
+#endif
+  for (int it = 0; it < ntasks; it++) {
+    const auto& task = tasks[it];
+    fillBarrelTrackInfo(mBarrelTracksInfo[it], task.collisionID, task.collisionBC, GIndices[task.entry], data, bcsMap);
+  }
+  LOGP(debug, "Processed {} barrel tracks with {} threads", ntasks, mNThreads);
+}
+
 AODProducerWorkflowDPL::TrackQA AODProducerWorkflowDPL::processBarrelTrackQA(int collisionID, std::uint64_t collisionBC, GIndex trackIndex,
-                                                                             const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+                                                                             const o2::globaltracking::RecoContainer& data, const FlatBCMap& bcsMap)
 {
   TrackQA trackQAHolder;
   auto contributorsGID = data.getTPCContributorGID(trackIndex);
@@ -2745,7 +2796,7 @@ void AODProducerWorkflowDPL::finaliseCCDB(ConcreteDataMatcher& matcher, void* ob
 }
 
 void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
-                                                   const o2::globaltracking::RecoContainer& data, std::map<uint64_t, int>& bcsMap)
+                                                   const o2::globaltracking::RecoContainer& data, FlatBCMap& bcsMap)
 {
   // Orphan tracks need to refer to some globalBC and for tracks with TOF this BC should be whithin an orbit
   // from the track abs time (to guarantee time precision). Therefore, we may need to insert some dummy globalBCs
@@ -2769,6 +2820,7 @@ void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTra
   }
   // the bscMap has at least TF start BC
   std::uint64_t maxBC = mStartIR.toLong();
+  std::vector<uint64_t> tofBCs;
   const auto& tofClus = data.getTOFClusters();
   for (int src = GIndex::NSources; src--;) {
     if (!GIndex::getSourceDetectorsMask(src)[o2::detectors::DetID::TOF]) { // check only tracks with TOF contribution
@@ -2796,30 +2848,38 @@ void AODProducerWorkflowDPL::addRefGlobalBCsForTOF(const o2::dataformats::VtxTra
       double exp = intLen * energy / (cSpeed * tofExpMom);
       auto tofSignal = (tofMatch.getSignal() - exp) * 1e-3; // time in ns wrt TF start
       auto bc = relativeTime_to_GlobalBC(tofSignal);
-
-      auto it = bcsMap.lower_bound(bc);
-      if (it == bcsMap.end() || it->first > bc + maxGapBC) {
-        bcsMap.emplace_hint(it, bc, 1);
-        LOG(debug) << "adding dummy BC " << bc;
-      }
+      tofBCs.push_back(bc);
       if (bc > maxBC) {
         maxBC = bc;
       }
     }
   }
+  // add dummy BCs starting from the latest TOF BC: the closest reference BC >= bc is either the closest existing one or the last added dummy
+  std::sort(tofBCs.begin(), tofBCs.end());
+  const auto& bcs = bcsMap.getBCs();
+  std::vector<uint64_t> dummyBCs;
+  uint64_t lastDummyBC = std::numeric_limits<uint64_t>::max();
+  for (auto itTOF = tofBCs.rbegin(); itTOF != tofBCs.rend(); ++itTOF) {
+    auto bc = *itTOF;
+    auto it = std::lower_bound(bcs.begin(), bcs.end(), bc);
+    auto nextBC = std::min(it == bcs.end() ? std::numeric_limits<uint64_t>::max() : *it, lastDummyBC);
+    if (nextBC == std::numeric_limits<uint64_t>::max() || nextBC > bc + maxGapBC) {
+      dummyBCs.push_back(bc);
+      lastDummyBC = bc;
+      LOG(debug) << "adding dummy BC " << bc;
+    }
+  }
   // make sure there is a globalBC exceeding the max encountered bc
-  if ((--bcsMap.end())->first <= maxBC) {
-    bcsMap.emplace_hint(bcsMap.end(), maxBC + 1, 1);
+  if (bcsMap.back() <= maxBC) {
+    dummyBCs.push_back(maxBC + 1);
   }
-  // renumber BCs
-  int bcID = 0;
-  for (auto& item : bcsMap) {
-    item.second = bcID;
-    bcID++;
+  for (auto bc : dummyBCs) {
+    bcsMap.add(bc);
   }
+  bcsMap.finalize(); // renumber BCs
 }
 
-std::uint64_t AODProducerWorkflowDPL::fillBCSlice(int (&slice)[2], double tmin, double tmax, const std::map<uint64_t, int>& bcsMap) const
+std::uint64_t AODProducerWorkflowDPL::fillBCSlice(int (&slice)[2], double tmin, double tmax, const FlatBCMap& bcsMap) const
 {
   // for ambiguous tracks (no or multiple vertices) we store the BC slice corresponding to track time window used for track-vertex matching,
   // see VertexTrackMatcher::extractTracks creator method, i.e. central time estimated +- uncertainty defined as:
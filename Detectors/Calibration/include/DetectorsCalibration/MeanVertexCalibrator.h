@@ -45,7 +45,7 @@ class MeanVertexCalibrator final : public o2::calibration::TimeSlotCalibration<o
   };
 
   MeanVertexCalibrator() = default;
-  ~MeanVertexCalibrator() final = default;
+  ~MeanVertexCalibrator() final { stopFinalizationThread(); }
 
   bool hasEnoughData(const Slot& slot) const final;
   void initOutput() final;
@@ -35,10 +35,11 @@ class TimeSlot
  public:
   TimeSlot() = default;
   TimeSlot(TFType tfS, TFType tfE) : mTFStart(tfS), mTFEnd(tfE) {}
-  TimeSlot(const TimeSlot& src) : mTFStart(src.mTFStart), mTFEnd(src.mTFEnd), mEntries(src.mEntries), mRunStartOrbit(src.mRunStartOrbit), mTFStartMS(src.mTFStartMS)
+  TimeSlot(const TimeSlot& src) : mTFStart(src.mTFStart), mTFEnd(src.mTFEnd), mEntries(src.mEntries), mRunStartOrbit(src.mRunStartOrbit), mTFStartMS(src.mTFStartMS), mFixedStartTimeMS(src.mFixedStartTimeMS), mFixedEndTimeMS(src.mFixedEndTimeMS)
   {
     mContainer = src.mContainer ? std::make_unique<Container>(*src.mContainer) : nullptr;
   }
+  TimeSlot(TimeSlot&& src) = default;
   TimeSlot& operator=(TimeSlot&& src) = default;
 
   ~TimeSlot() = default;
@@ -47,8 +48,8 @@ class TimeSlot
   TFType getTFEnd() const { return mTFEnd; }
 
   long getStaticStartTimeMS() const { return mTFStartMS; }
-  long getStartTimeMS() const { return o2::base::GRPGeomHelper::instance().getOrbitResetTimeMS() + (mRunStartOrbit + long(o2::base::GRPGeomHelper::getNHBFPerTF()) * mTFStart) * o2::constants::lhc::LHCOrbitMUS / 1000; }
-  long getEndTimeMS() const { return o2::base::GRPGeomHelper::instance().getOrbitResetTimeMS() + (mRunStartOrbit + long(o2::base::GRPGeomHelper::getNHBFPerTF()) * (mTFEnd + 1)) * o2::constants::lhc::LHCOrbitMUS / 1000; }
+  long getStartTimeMS() const { return mFixedStartTimeMS >= 0 ? mFixedStartTimeMS : o2::base::GRPGeomHelper::instance().getOrbitResetTimeMS() + (mRunStartOrbit + long(o2::base::GRPGeomHelper::getNHBFPerTF()) * mTFStart) * o2::constants::lhc::LHCOrbitMUS / 1000; }
+  long getEndTimeMS() const { return mFixedEndTimeMS >= 0 ? mFixedEndTimeMS : o2::base::GRPGeomHelper::instance().getOrbitResetTimeMS() + (mRunStartOrbit + long(o2::base::GRPGeomHelper::getNHBFPerTF()) * (mTFEnd + 1)) * o2::constants::lhc::LHCOrbitMUS / 1000; }
 
   const Container* getContainer() const { return mContainer.get(); }
   Container* getContainer() { return mContainer.get(); }
@@ -59,6 +60,14 @@ class TimeSlot
   void setStaticStartTimeMS(long t) { mTFStartMS = t; }
   void setRunStartOrbit(long t) { mRunStartOrbit = t; }
   auto getRunStartOrbit() const { return mRunStartOrbit; }
+  // evaluate the start/end times with the current orbit reset time and keep them, e.g. before handing the slot over to another thread
+  void fixTimeBoundsMS()
+  {
+    mFixedStartTimeMS = mFixedEndTimeMS = -1;
+    auto startMS = getStartTimeMS(), endMS = getEndTimeMS();
+    mFixedStartTimeMS = startMS;
+    mFixedEndTimeMS = endMS;
+  }
 
   // compare the TF with this slot boundaties
   int relateToTF(TFType tf) { return tf < mTFStart ? -1 : (tf > mTFEnd ? 1 : 0); }
@@ -84,6 +93,8 @@ class TimeSlot
   long mRunStartOrbit = 0;
   std::unique_ptr<Container> mContainer; // user object to accumulate the calibration data for this slot
   long mTFStartMS = 0;                   // start time of the slot in ms that avoids to calculate it on the fly; needed when a slot covers more runs, otherwise the OrbitReset that is read is the one of the latest run, and the validity will be wrong
+  long mFixedStartTimeMS = -1;           //! start time in ms fixed by fixTimeBoundsMS, -1 if evaluated on the fly
+  long mFixedEndTimeMS = -1;             //! end time in ms fixed by fixTimeBoundsMS, -1 if evaluated on the fly
 
   ClassDefNV(TimeSlot, 2);
 };
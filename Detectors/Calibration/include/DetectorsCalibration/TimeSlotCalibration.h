@@ -25,6 +25,9 @@
 #include <gsl/gsl>
 #include <limits>
 #include <type_traits>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <unistd.h>
 
 namespace o2
@@ -46,7 +49,12 @@ class TimeSlotCalibration
   static constexpr TFType INFINITE_TF = o2::calibration::INFINITE_TF;
 
   TimeSlotCalibration() = default;
-  virtual ~TimeSlotCalibration() = default;
+  virtual ~TimeSlotCalibration()
+  {
+    if (mFinalizationThread.joinable()) { // cannot be stopped here since finalizeSlot of the destroyed derived class may be running
+      LOG(fatal) << "Asynchronous finalization thread must be stopped by stopFinalizationThread in the destructor of the derived class";
+    }
+  }
   float getMaxSlotsDelay() const { return mMaxSlotsDelay; }
   void setMaxSlotsDelay(float v) { mMaxSlotsDelay = v > 0. ? v : 0.; }
 
@@ -97,6 +105,34 @@ class TimeSlotCalibration
 
   void setUpdateAtTheEndOfRunOnly() { mUpdateAtTheEndOfRunOnly = kTRUE; }
 
+  // In the asynchronous finalization mode the slots ready to be finalized are moved to the dedicated thread calling finalizeSlot,
+  // while the new TFs keep filling the mSlots. The finalizeSlot of the derived class must then modify only the slot and the output
+  // data members, and the output must be accessed by the device only via consumeFinalizedOutput.
+  // The time bounds of the slot are fixed when it is queued, since the orbit reset time may be updated meanwhile by the main thread.
+  // The derived class opting in must call stopFinalizationThread in its destructor.
+  void setAsyncFinalization(bool v)
+  {
+    if (!v) {
+      waitForFinalization();
+    }
+    mAsyncFinalization = v;
+  }
+  bool isAsyncFinalization() const { return mAsyncFinalization; }
+  // number of slots queued or being finalized
+  size_t getNSlotsInFinalization() const
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationQueueMtx);
+    return mNSlotsInFinalization;
+  }
+  void waitForFinalization();
+  // finalize the slots still in the queue and join the finalization thread
+  void stopFinalizationThread();
+  // If there are finalized slots whose output was not yet consumed, call consumer (which should e.g. send the output and call initOutput)
+  // with exclusive access to the output. Unless wait is requested, return w/o blocking if the finalization thread is busy with the output.
+  // Return the number of slots whose output was consumed.
+  template <typename F>
+  size_t consumeFinalizedOutput(F&& consumer, bool wait = false);
+
   int getNSlots() const { return mSlots.size(); }
   Slot& getSlotForTF(TFType tf);
   Slot& getSlot(int i) { return (Slot&)mSlots.at(i); }
@@ -111,6 +147,7 @@ class TimeSlotCalibration
 
   virtual void reset()
   { // reset to virgin state (need for start - stop - start)
+    waitForFinalization();
     mSlots.clear();
     mLastClosedTF = 0;
     mFirstTF = 0;
@@ -219,6 +256,9 @@ class TimeSlotCalibration
   }
 
   TFType tf2SlotMin(TFType tf) const;
+  // finalize the slot or, in the async. mode, move its content to the finalization queue
+  void finalizeOrQueueSlot(Slot& slot);
+  void finalizationLoop();
 
   std::deque<Slot> mSlots;
 
@@ -249,6 +289,19 @@ class TimeSlotCalibration
   TimeSlotMetaData mSaveMetaData{};
   bool mSavedSlotAllowed = false;
 
+  //>> asynchronous finalization
+  bool mAsyncFinalization = false;
+  bool mStopFinalization = false;               //! request to stop the finalization thread
+  size_t mNSlotsInFinalization = 0;             //! number of slots queued or being finalized
+  size_t mNSlotsFinalized = 0;                  //! number of slots finalized but whose output was not consumed
+  std::deque<Slot> mSlotsToFinalize;            //! slots waiting for finalization
+  mutable std::mutex mFinalizationQueueMtx;     //! protects the finalization queue and counters
+  std::mutex mOutputMtx;                        //! protects the output filled by finalizeSlot
+  std::condition_variable mFinalizationQueueCV; //! signals new slot in the queue
+  std::condition_variable mFinalizationDoneCV;  //! signals finalization of the slot
+  std::thread mFinalizationThread;              //! worker thread
+  //<< asynchronous finalization
+
   ClassDef(TimeSlotCalibration, 1);
 };
 
@@ -320,7 +373,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
         mSlots[0].setTFStart(mLastClosedTF);
         mSlots[0].setTFEnd(mMaxSeenTF);
         LOG(info) << "Finalizing slot for " << mSlots[0].getTFStart() << " <= TF <= " << mSlots[0].getTFEnd();
-        finalizeSlot(mSlots[0]);                  // will be removed after finalization
+        finalizeOrQueueSlot(mSlots[0]);           // will be removed after finalization
         mLastClosedTF = mSlots[0].getTFEnd() < INFINITE_TF ? (mSlots[0].getTFEnd() + 1) : mSlots[0].getTFEnd() < INFINITE_TF; // will not accept any TF below this
         mSlots.erase(mSlots.begin());
         // creating a new slot if we are not at the end of run
@@ -344,7 +397,7 @@ void TimeSlotCalibration<Container>::checkSlotsToFinalize(TFType tf, int maxDela
       if (tfLim < tf) {
         if (hasEnoughData(*slot)) {
           LOG(debug) << "Finalizing slot for " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd();
-          finalizeSlot(*slot); // will be removed after finalization
+          finalizeOrQueueSlot(*slot); // will be removed after finalization
         } else if ((slot + 1) != mSlots.end()) {
           LOG(info) << "Merging underpopulated slot " << slot->getTFStart() << " <= TF <= " << slot->getTFEnd()
                     << " to slot " << (slot + 1)->getTFStart() << " <= TF <= " << (slot + 1)->getTFEnd();
@@ -372,11 +425,114 @@ void TimeSlotCalibration<Container>::finalizeOldestSlot()
     LOG(warning) << "There are no slots defined";
     return;
   }
-  finalizeSlot(mSlots.front());
+  finalizeOrQueueSlot(mSlots.front());
   mLastClosedTF = mSlots.front().getTFEnd() + 1; // do not accept any TF below this
   mSlots.erase(mSlots.begin());
 }
 
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::finalizeOrQueueSlot(Slot& slot)
+{
+  if (!mAsyncFinalization) {
+    std::lock_guard<std::mutex> lock(mOutputMtx);
+    finalizeSlot(slot);
+    mNSlotsFinalized++;
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationQueueMtx);
+    if (!mFinalizationThread.joinable()) {
+      mStopFinalization = false;
+      mFinalizationThread = std::thread(&TimeSlotCalibration<Container>::finalizationLoop, this);
+    }
+    slot.fixTimeBoundsMS();                         // the orbit reset time may be updated by the main thread during finalization
+    mSlotsToFinalize.emplace_back(std::move(slot)); // the slot boundaries stay valid in the moved-from object
+    mNSlotsInFinalization++;
+  }
+  mFinalizationQueueCV.notify_one();
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::finalizationLoop()
+{
+  while (true) {
+    Slot slot;
+    {
+      std::unique_lock<std::mutex> lock(mFinalizationQueueMtx);
+      mFinalizationQueueCV.wait(lock, [this] { return mStopFinalization || !mSlotsToFinalize.empty(); });
+      if (mSlotsToFinalize.empty()) { // stop requested and nothing left to finalize
+        break;
+      }
+      slot = std::move(mSlotsToFinalize.front());
+      mSlotsToFinalize.pop_front();
+    }
+    LOG(debug) << "Asynchronously finalizing slot for " << slot.getTFStart() << " <= TF <= " << slot.getTFEnd();
+    {
+      std::lock_guard<std::mutex> lock(mOutputMtx);
+      finalizeSlot(slot);
+      mNSlotsFinalized++;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mFinalizationQueueMtx);
+      mNSlotsInFinalization--;
+    }
+    mFinalizationDoneCV.notify_all();
+  }
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::waitForFinalization()
+{
+  std::unique_lock<std::mutex> lock(mFinalizationQueueMtx);
+  mFinalizationDoneCV.wait(lock, [this] { return mNSlotsInFinalization == 0; });
+}
+
+//_________________________________________________
+template <typename Container>
+void TimeSlotCalibration<Container>::stopFinalizationThread()
+{
+  // stop the thread once all queued slots are finalized, their output is left for consumeFinalizedOutput
+  {
+    std::lock_guard<std::mutex> lock(mFinalizationQueueMtx);
+    if (!mFinalizationThread.joinable()) {
+      return;
+    }
+    if (!mSlotsToFinalize.empty()) {
+      LOGP(info, "Finalizing {} queued slots before stopping the finalization thread", mSlotsToFinalize.size());
+    }
+    mStopFinalization = true;
+  }
+  mFinalizationQueueCV.notify_one();
+  mFinalizationThread.join();
+  std::lock_guard<std::mutex> lock(mFinalizationQueueMtx);
+  mStopFinalization = false;
+}
+
+//_________________________________________________
+template <typename Container>
+template <typename F>
+size_t TimeSlotCalibration<Container>::consumeFinalizedOutput(F&& consumer, bool wait)
+{
+  if (wait) {
+    waitForFinalization();
+  }
+  std::unique_lock<std::mutex> lock(mOutputMtx, std::defer_lock);
+  if (wait) {
+    lock.lock();
+  } else if (!lock.try_lock()) {
+    return 0; // output is being filled, will be consumed later
+  }
+  auto nSlots = mNSlotsFinalized;
+  if (nSlots) {
+    consumer();
+    mNSlotsFinalized = 0;
+  }
+  return nSlots;
+}
+
 //________________________________________
 template <typename Container>
 inline TFType TimeSlotCalibration<Container>::tf2SlotMin(TFType tf) const
@@ -38,6 +38,10 @@ void MeanVertexCalibDevice::init(InitContext& ic)
   if (useVerboseMode) {
     mCalibrator->useVerboseMode(true);
   }
+  if (ic.options().get<bool>("async-finalization")) {
+    LOG(info) << "Slots will be finalized asynchronously";
+    mCalibrator->setAsyncFinalization(true);
+  }
 }
 
 //_____________________________________________________________
@@ -55,6 +59,12 @@ void MeanVertexCalibDevice::run(o2::framework::ProcessingContext& pc)
   o2::base::TFIDInfoHelper::fillTFIDInfo(pc, mCalibrator->getCurrentTFInfo());
   LOG(debug) << "Processing TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices";
   mCalibrator->process(data);
+  if (mCalibrator->isAsyncFinalization()) { // send what was finalized so far, w/o waiting for the slots being finalized
+    auto nSlots = mCalibrator->consumeFinalizedOutput([this, &pc]() { sendOutput(pc.outputs()); });
+    LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, sent output of " << nSlots
+                << " finalized slots, " << mCalibrator->getNSlotsInFinalization() << " slots are being finalized";
+    return;
+  }
   sendOutput(pc.outputs());
   const auto& infoVec = mCalibrator->getMeanVertexObjectInfoVector();
   LOG(detail) << "Processed TF " << mCalibrator->getCurrentTFInfo().tfCounter << " with " << data.size() << " vertices, for which we created " << infoVec.size() << " objects for TF " << mCalibrator->getCurrentTFInfo().tfCounter;
@@ -73,6 +83,10 @@ void MeanVertexCalibDevice::endOfStream(o2::framework::EndOfStreamContext& ec)
 
   LOG(info) << "Finalizing calibration";
   mCalibrator->checkSlotsToFinalize(o2::calibration::INFINITE_TF);
+  if (mCalibrator->isAsyncFinalization()) {
+    mCalibrator->consumeFinalizedOutput([this, &ec]() { sendOutput(ec.outputs()); }, true); // wait for all slots to be finalized
+    return;
+  }
   sendOutput(ec.outputs());
 }
 
@@ -153,7 +167,8 @@ DataProcessorSpec getMeanVertexCalibDeviceSpec(uint32_t dcsMVsubspec)
     inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<device>(ccdbRequest, dcsMVsubspec)},
-    Options{{"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}}}};
+    Options{{"use-verbose-mode", VariantType::Bool, false, {"Use verbose mode"}},
+            {"async-finalization", VariantType::Bool, false, {"Finalize slots in a separate thread w/o blocking the processing of new TFs"}}}};
 }
 
 } // namespace framework
@@ -56,10 +56,10 @@ void StrangenessTrackerSpec::init(framework::InitContext& ic)
   o2::base::GRPGeomHelper::instance().setRequest(mGGCCDBRequest);
   mTracker.setCorrType(o2::base::PropagatorImpl<float>::MatCorrType::USEMatCorrLUT);
   mTracker.setConfigParams(&StrangenessTrackingParamConfig::Instance());
-  mTracker.setupThreads(1);
+  mTracker.setupThreads(ic.options().get<int>("threads"));
   mTracker.setupFitters();
 
-  LOG(info) << "Initialized strangeness tracker...";
+  LOG(info) << "Initialized strangeness tracker with " << mTracker.getNThreads() << " thread(s)...";
 }
 
 void StrangenessTrackerSpec::run(framework::ProcessingContext& pc)
@@ -163,7 +163,7 @@ DataProcessorSpec getStrangenessTrackerSpec(o2::dataformats::GlobalTrackID::mask
     dataRequest->inputs,
     outputs,
     AlgorithmSpec{adaptFromTask<StrangenessTrackerSpec>(dataRequest, ggRequest, useMC)},
-    Options{}};
+    Options{{"threads", VariantType::Int, 1, {"Number of threads"}}}};
 }
 
 } // namespace strangeness_tracking
@@ -61,6 +61,7 @@ class TPCInterpolationDPL : public Task
   bool mSendTrackData{false};     ///< if true, not only the clusters but also corresponding track data will be sent
   uint32_t mSlotLength{600u};     ///< the length of one calibration slot required to calculate max number of tracks per TF
   int mMatCorr{2};                ///< the material correction to be used for track interpolation
+  int mNThreads{1};               ///< number of threads used for the track interpolation
   TStopwatch mTimer;
 };
 
@@ -52,6 +52,7 @@ void TPCInterpolationDPL::init(InitContext& ic)
   mSlotLength = ic.options().get<uint32_t>("sec-per-slot");
   mProcessSeeds = ic.options().get<bool>("process-seeds");
   mMatCorr = ic.options().get<int>("matCorrType");
+  mNThreads = ic.options().get<int>("nthreads");
   if (mProcessSeeds && mSources != mSourcesMap) {
     LOG(fatal) << "process-seeds option is not compatible with using different track sources for vDrift and map extraction";
   }
@@ -89,6 +90,7 @@ void TPCInterpolationDPL::updateTimeDependentParams(ProcessingContext& pc)
     }
     mInterpolation.setMaxTracksPerTF(nTracksPerTfMax);
     mInterpolation.setMatCorr(static_cast<o2::base::Propagator::MatCorrType>(mMatCorr));
+    mInterpolation.setNThreads(mNThreads);
     if (mProcessSeeds) {
       mInterpolation.setProcessSeeds();
     }
@@ -203,7 +205,8 @@ DataProcessorSpec getTPCInterpolationSpec(GTrackID::mask_t srcCls, GTrackID::mas
     Options{
       {"matCorrType", VariantType::Int, 2, {"material correction type (definition in Propagator.h)"}},
       {"sec-per-slot", VariantType::UInt32, 600u, {"number of seconds per calibration time slot (put 0 for infinite slot length)"}},
-      {"process-seeds", VariantType::Bool, false, {"do not remove duplicates, e.g. for ITS-TPC-TRD track also process its seeding ITS-TPC part"}}}};
+      {"process-seeds", VariantType::Bool, false, {"do not remove duplicates, e.g. for ITS-TPC-TRD track also process its seeding ITS-TPC part"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads used for the track inter-/extrapolation"}}}};
 }
 
 } // namespace tpc
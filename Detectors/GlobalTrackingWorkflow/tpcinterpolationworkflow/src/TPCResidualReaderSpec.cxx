@@ -104,6 +104,7 @@ void TPCResidualReader::init(InitContext& ic)
   auto fileList = o2::RangeTokenizer::tokenize<std::string>(ic.options().get<std::string>("residuals-infiles"));
   mOutfile = ic.options().get<std::string>("outfile");
   mTrackResiduals.init();
+  mTrackResiduals.setNThreads(ic.options().get<int>("nthreads"));
 
   // check if only one input file (a txt file contaning a list of files is provided)
   if (fileList.size() == 1) {
@@ -323,6 +324,7 @@ DataProcessorSpec getTPCResidualReaderSpec(bool doBinning, GID::mask_t src)
       {"outfile", VariantType::String, "debugVoxRes.root", {"Output file name"}},
       {"store-binned", VariantType::Bool, false, {"Store the binned residuals together with the voxel results"}},
       {"dont-check-file-access", VariantType::Bool, false, {"Deactivate check if all files are accessible before adding them to the list of files"}},
+      {"nthreads", VariantType::Int, 1, {"Number of threads used to process the voxels of a sector"}},
     }};
 }
 
@@ -280,8 +280,12 @@ void TimeFrame::initialise(const int iteration, const TrackingParameters& trkPar
     mIndexTableUtils.setTrackingParameters(trkParam);
     mPositionResolution.resize(trkParam.NLayers);
     mBogusClusters.resize(trkParam.NLayers, 0);
-    deepVectorClear(mLines);
-    deepVectorClear(mTrackletClusters);
+    for (auto& lines : mLines) { // keep the per-ROF buffers of the vertexer allocated across TFs
+      lines.clear();
+    }
+    for (auto& clusters : mTrackletClusters) {
+      clusters.clear();
+    }
     for (unsigned int iLayer{0}; iLayer < std::min((int)mClusters.size(), maxLayers); ++iLayer) {
       deepVectorClear(mClusters[iLayer]);
       mClusters[iLayer].resize(mUnsortedClusters[iLayer].size());
@@ -332,30 +332,34 @@ void VertexerTraits::computeTracklets()
 
 void VertexerTraits::computeTrackletMatching()
 {
-#pragma omp parallel for num_threads(mNThreads) schedule(dynamic)
-  for (int pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) {
-    mTimeFrame->getLines(pivotRofId).reserve(mTimeFrame->getNTrackletsCluster(pivotRofId, 0).size());
-    std::vector<bool> usedTracklets(mTimeFrame->getFoundTracklets(pivotRofId, 0).size(), false);
-    int startROF{std::max(0, pivotRofId - mVrtParams.deltaRof)};
-    int endROF{std::min(mTimeFrame->getNrof(), pivotRofId + mVrtParams.deltaRof + 1)};
-    for (auto targetRofId = startROF; targetRofId < endROF; ++targetRofId) {
-      trackletSelectionKernelHost(
-        mTimeFrame->getClustersOnLayer(targetRofId, 0),
-        mTimeFrame->getClustersOnLayer(pivotRofId, 1),
-        mTimeFrame->getUsedClustersROF(targetRofId, 0),
-        mTimeFrame->getUsedClustersROF(targetRofId, 2),
-        mTimeFrame->getFoundTracklets(pivotRofId, 0),
-        mTimeFrame->getFoundTracklets(pivotRofId, 1),
-        usedTracklets,
-        mTimeFrame->getNTrackletsCluster(pivotRofId, 0),
-        mTimeFrame->getNTrackletsCluster(pivotRofId, 1),
-        mTimeFrame->getLines(pivotRofId),
-        mTimeFrame->getLabelsFoundTracklets(pivotRofId, 0),
-        mTimeFrame->getLinesLabel(pivotRofId),
-        pivotRofId,
-        targetRofId,
-        mVrtParams.tanLambdaCut,
-        mVrtParams.phiCut);
+#pragma omp parallel num_threads(mNThreads)
+  {
+    std::vector<bool> usedTracklets; // per-thread scratch, reused across ROFs
+#pragma omp for schedule(dynamic)
+    for (int pivotRofId = 0; pivotRofId < mTimeFrame->getNrof(); ++pivotRofId) {
+      mTimeFrame->getLines(pivotRofId).reserve(mTimeFrame->getNTrackletsCluster(pivotRofId, 0).size());
+      usedTracklets.assign(mTimeFrame->getFoundTracklets(pivotRofId, 0).size(), false);
+      int startROF{std::max(0, pivotRofId - mVrtParams.deltaRof)};
+      int endROF{std::min(mTimeFrame->getNrof(), pivotRofId + mVrtParams.deltaRof + 1)};
+      for (auto targetRofId = startROF; targetRofId < endROF; ++targetRofId) {
+        trackletSelectionKernelHost(
+          mTimeFrame->getClustersOnLayer(targetRofId, 0),
+          mTimeFrame->getClustersOnLayer(pivotRofId, 1),
+          mTimeFrame->getUsedClustersROF(targetRofId, 0),
+          mTimeFrame->getUsedClustersROF(targetRofId, 2),
+          mTimeFrame->getFoundTracklets(pivotRofId, 0),
+          mTimeFrame->getFoundTracklets(pivotRofId, 1),
+          usedTracklets,
+          mTimeFrame->getNTrackletsCluster(pivotRofId, 0),
+          mTimeFrame->getNTrackletsCluster(pivotRofId, 1),
+          mTimeFrame->getLines(pivotRofId),
+          mTimeFrame->getLabelsFoundTracklets(pivotRofId, 0),
+          mTimeFrame->getLinesLabel(pivotRofId),
+          pivotRofId,
+          targetRofId,
+          mVrtParams.tanLambdaCut,
+          mVrtParams.phiCut);
+      }
     }
   }
 
@@ -392,91 +396,101 @@ void VertexerTraits::computeTrackletMatching()
 
 void VertexerTraits::computeVertices()
 {
-
   auto nsigmaCut{std::min(mVrtParams.vertNsigmaCut * mVrtParams.vertNsigmaCut * (mVrtParams.vertRadiusSigma * mVrtParams.vertRadiusSigma + mVrtParams.trackletSigma * mVrtParams.trackletSigma), 1.98f)};
   std::vector<Vertex> vertices;
 #ifdef VTX_DEBUG
   std::vector<std::vector<ClusterLines>> dbg_clusLines(mTimeFrame->getNrof());
 #endif
   std::vector<int> noClustersVec(mTimeFrame->getNrof(), 0);
-  for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
-    const int numTracklets{static_cast<int>(mTimeFrame->getLines(rofId).size())};
+  // The beam position is only updated when the vertices are added to the TF, the beam line is the same for all ROFs
+  const auto beamLine = Line{{mTimeFrame->getBeamX(), mTimeFrame->getBeamY(), -50.f}, {mTimeFrame->getBeamX(), mTimeFrame->getBeamY(), 50.f}}; // use beam position as contributor
 
-    std::vector<bool> usedTracklets(numTracklets, false);
-    for (int line1{0}; line1 < numTracklets; ++line1) {
-      if (usedTracklets[line1]) {
-        continue;
-      }
-      for (int line2{line1 + 1}; line2 < numTracklets; ++line2) {
-        if (usedTracklets[line2]) {
+  // Line clustering and cluster merging are independent per ROF, the vertex selection below is not (beam position update)
+#pragma omp parallel num_threads(mNThreads)
+  {
+    std::vector<bool> usedTracklets; // per-thread scratch, reused across ROFs
+#pragma omp for schedule(dynamic)
+    for (int rofId = 0; rofId < mTimeFrame->getNrof(); ++rofId) {
+      const auto& lines = mTimeFrame->getLines(rofId);
+      auto& clusters = mTimeFrame->getTrackletClusters(rofId);
+      const int numTracklets{static_cast<int>(lines.size())};
+      usedTracklets.assign(numTracklets, false);
+      for (int line1{0}; line1 < numTracklets; ++line1) {
+        if (usedTracklets[line1]) {
           continue;
         }
-        auto dca{Line::getDCA(mTimeFrame->getLines(rofId)[line1], mTimeFrame->getLines(rofId)[line2])};
-        if (dca < mVrtParams.pairCut) {
-          mTimeFrame->getTrackletClusters(rofId).emplace_back(line1, mTimeFrame->getLines(rofId)[line1], line2, mTimeFrame->getLines(rofId)[line2]);
-          std::array<float, 3> tmpVertex{mTimeFrame->getTrackletClusters(rofId).back().getVertex()};
-          if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
-            mTimeFrame->getTrackletClusters(rofId).pop_back();
-            break;
+        for (int line2{line1 + 1}; line2 < numTracklets; ++line2) {
+          if (usedTracklets[line2]) {
+            continue;
           }
-          usedTracklets[line1] = true;
-          usedTracklets[line2] = true;
-          for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
-            if (usedTracklets[tracklet3]) {
-              continue;
+          auto dca{Line::getDCA(lines[line1], lines[line2])};
+          if (dca < mVrtParams.pairCut) {
+            clusters.emplace_back(line1, lines[line1], line2, lines[line2]);
+            std::array<float, 3> tmpVertex{clusters.back().getVertex()};
+            if (tmpVertex[0] * tmpVertex[0] + tmpVertex[1] * tmpVertex[1] > 4.f) {
+              clusters.pop_back();
+              break;
             }
-            if (Line::getDistanceFromPoint(mTimeFrame->getLines(rofId)[tracklet3], tmpVertex) < mVrtParams.pairCut) {
-              mTimeFrame->getTrackletClusters(rofId).back().add(tracklet3, mTimeFrame->getLines(rofId)[tracklet3]);
-              usedTracklets[tracklet3] = true;
-              tmpVertex = mTimeFrame->getTrackletClusters(rofId).back().getVertex();
+            usedTracklets[line1] = true;
+            usedTracklets[line2] = true;
+            for (int tracklet3{0}; tracklet3 < numTracklets; ++tracklet3) {
+              if (usedTracklets[tracklet3]) {
+                continue;
+              }
+              if (Line::getDistanceFromPoint(lines[tracklet3], tmpVertex) < mVrtParams.pairCut) {
+                clusters.back().add(tracklet3, lines[tracklet3]);
+                usedTracklets[tracklet3] = true;
+                tmpVertex = clusters.back().getVertex();
+              }
             }
+            break;
           }
-          break;
         }
       }
-    }
-    if (mVrtParams.allowSingleContribClusters) {
-      auto beamLine = Line{{mTimeFrame->getBeamX(), mTimeFrame->getBeamY(), -50.f}, {mTimeFrame->getBeamX(), mTimeFrame->getBeamY(), 50.f}}; // use beam position as contributor
-      for (size_t iLine{0}; iLine < numTracklets; ++iLine) {
-        if (!usedTracklets[iLine]) {
-          auto dca = Line::getDCA(mTimeFrame->getLines(rofId)[iLine], beamLine);
-          if (dca < mVrtParams.pairCut) {
-            mTimeFrame->getTrackletClusters(rofId).emplace_back(iLine, mTimeFrame->getLines(rofId)[iLine], -1, beamLine); // beamline must be passed as second line argument
+      if (mVrtParams.allowSingleContribClusters) {
+        for (int iLine{0}; iLine < numTracklets; ++iLine) {
+          if (!usedTracklets[iLine]) {
+            auto dca = Line::getDCA(lines[iLine], beamLine);
+            if (dca < mVrtParams.pairCut) {
+              clusters.emplace_back(iLine, lines[iLine], -1, beamLine); // beamline must be passed as second line argument
+            }
           }
         }
       }
-    }
 
-    // Cluster merging
-    std::sort(mTimeFrame->getTrackletClusters(rofId).begin(), mTimeFrame->getTrackletClusters(rofId).end(),
-              [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); });
-    noClustersVec[rofId] = static_cast<int>(mTimeFrame->getTrackletClusters(rofId).size());
-    for (int iCluster1{0}; iCluster1 < noClustersVec[rofId]; ++iCluster1) {
-      std::array<float, 3> vertex1{mTimeFrame->getTrackletClusters(rofId)[iCluster1].getVertex()};
-      std::array<float, 3> vertex2{};
-      for (int iCluster2{iCluster1 + 1}; iCluster2 < noClustersVec[rofId]; ++iCluster2) {
-        vertex2 = mTimeFrame->getTrackletClusters(rofId)[iCluster2].getVertex();
-        if (o2::gpu::GPUCommonMath::Abs(vertex1[2] - vertex2[2]) < mVrtParams.clusterCut) {
-          float distance{(vertex1[0] - vertex2[0]) * (vertex1[0] - vertex2[0]) +
-                         (vertex1[1] - vertex2[1]) * (vertex1[1] - vertex2[1]) +
-                         (vertex1[2] - vertex2[2]) * (vertex1[2] - vertex2[2])};
-          if (distance < mVrtParams.pairCut * mVrtParams.pairCut) {
-            for (auto label : mTimeFrame->getTrackletClusters(rofId)[iCluster2].getLabels()) {
-              mTimeFrame->getTrackletClusters(rofId)[iCluster1].add(label, mTimeFrame->getLines(rofId)[label]);
-              vertex1 = mTimeFrame->getTrackletClusters(rofId)[iCluster1].getVertex();
+      // Cluster merging
+      std::sort(clusters.begin(), clusters.end(),
+                [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); });
+      noClustersVec[rofId] = static_cast<int>(clusters.size());
+      for (int iCluster1{0}; iCluster1 < noClustersVec[rofId]; ++iCluster1) {
+        std::array<float, 3> vertex1{clusters[iCluster1].getVertex()};
+        std::array<float, 3> vertex2{};
+        for (int iCluster2{iCluster1 + 1}; iCluster2 < noClustersVec[rofId]; ++iCluster2) {
+          vertex2 = clusters[iCluster2].getVertex();
+          if (o2::gpu::GPUCommonMath::Abs(vertex1[2] - vertex2[2]) < mVrtParams.clusterCut) {
+            float distance{(vertex1[0] - vertex2[0]) * (vertex1[0] - vertex2[0]) +
+                           (vertex1[1] - vertex2[1]) * (vertex1[1] - vertex2[1]) +
+                           (vertex1[2] - vertex2[2]) * (vertex1[2] - vertex2[2])};
+            if (distance < mVrtParams.pairCut * mVrtParams.pairCut) {
+              for (auto label : clusters[iCluster2].getLabels()) {
+                clusters[iCluster1].add(label, lines[label]);
+                vertex1 = clusters[iCluster1].getVertex();
+              }
+              clusters.erase(clusters.begin() + iCluster2);
+              --iCluster2;
+              --noClustersVec[rofId];
             }
-            mTimeFrame->getTrackletClusters(rofId).erase(mTimeFrame->getTrackletClusters(rofId).begin() + iCluster2);
-            --iCluster2;
-            --noClustersVec[rofId];
           }
         }
       }
+      std::sort(clusters.begin(), clusters.end(),
+                [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); }); // ensure clusters are ordered by contributors, so that we can cat after the first.
     }
   }
+
+  // Vertex selection in ROF order: the beam position used for the selection is updated by the vertices of the previous ROFs
   for (int rofId{0}; rofId < mTimeFrame->getNrof(); ++rofId) {
     vertices.clear();
-    std::sort(mTimeFrame->getTrackletClusters(rofId).begin(), mTimeFrame->getTrackletClusters(rofId).end(),
-              [](ClusterLines& cluster1, ClusterLines& cluster2) { return cluster1.getSize() > cluster2.getSize(); }); // ensure clusters are ordered by contributors, so that we can cat after the first.
 #ifdef VTX_DEBUG
     for (auto& cl : mTimeFrame->getTrackletClusters(rofId)) {
       dbg_clusLines[rofId].push_back(cl);
@@ -0,0 +1,96 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief throughput of the ITS vertex finding (VertexerTraits::computeVertices) on a TF of synthetic tracklet lines,
+// as a function of the number of threads. Each ROF contains a few collisions with their lines plus random fake lines.
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include "ITStracking/ClusterLines.h"
+#include "ITStracking/Configuration.h"
+#include "ITStracking/TimeFrame.h"
+#include "ITStracking/VertexerTraits.h"
+
+using namespace o2::its;
+
+void createTimeFrame(TimeFrame& tf, int nRofs, int nVerticesPerRof, int nLinesPerVertex, int nFakesPerRof)
+{
+  // empty ROFs, the lines are filled directly
+  for (int rof = 0; rof < nRofs; rof++) {
+    for (size_t iL = 0; iL < tf.mROFramesClusters.size(); iL++) {
+      tf.mNClustersPerROF[iL].push_back(0);
+      tf.mROFramesClusters[iL].push_back(0);
+    }
+    tf.mNrof++;
+  }
+  TrackingParameters trkPars;
+  trkPars.PhiBins = 1;
+  trkPars.ZBins = 1;
+  tf.initialise(0, trkPars, 3);
+
+  std::mt19937 gen(12345);
+  std::normal_distribution<float> gausXY(0.f, 0.005f), gausZ(0.f, 5.f), gausDir(0.f, 0.003f);
+  std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+  auto addLine = [&tf](int rof, const std::array<float, 3>& p0, const std::array<float, 3>& p1) {
+    auto& line = tf.getLines(rof).emplace_back(p0, p1);
+    line.rof[0] = line.rof[1] = rof;
+  };
+  for (int rof = 0; rof < nRofs; rof++) {
+    for (int iv = 0; iv < nVerticesPerRof; iv++) {
+      std::array<float, 3> vtx{gausXY(gen), gausXY(gen), gausZ(gen)};
+      for (int il = 0; il < nLinesPerVertex; il++) {
+        float phi = M_PI * uniform(gen), tgl = uniform(gen);
+        std::array<float, 3> p0{vtx[0] + gausDir(gen), vtx[1] + gausDir(gen), vtx[2] + gausDir(gen)};
+        std::array<float, 3> p1{p0[0] + 3.f * std::cos(phi), p0[1] + 3.f * std::sin(phi), p0[2] + 3.f * tgl};
+        addLine(rof, p0, p1);
+      }
+    }
+    for (int il = 0; il < nFakesPerRof; il++) {
+      std::array<float, 3> p0{2.f * uniform(gen), 2.f * uniform(gen), 15.f * uniform(gen)};
+      std::array<float, 3> p1{4.f * uniform(gen), 4.f * uniform(gen), 15.f * uniform(gen)};
+      addLine(rof, p0, p1);
+    }
+  }
+}
+
+// state.range(0): number of threads
+// state.range(1): number of collisions per ROF
+static void BM_ComputeVertices(benchmark::State& state)
+{
+  const int nRofs = 576, nLinesPerVertex = 30, nFakesPerRof = 20;
+  TimeFrame tf;
+  createTimeFrame(tf, nRofs, state.range(1), nLinesPerVertex, nFakesPerRof);
+  VertexerTraits traits;
+  traits.adoptTimeFrame(&tf);
+  VertexingParameters vrtPars;
+  vrtPars.nThreads = state.range(0);
+  traits.updateVertexingParameters(vrtPars, TimeFrameGPUParameters{});
+  size_t nVertices = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int rof = 0; rof < nRofs; rof++) {
+      tf.getTrackletClusters(rof).clear();
+    }
+    tf.resetRofPV();
+    tf.resetBeamXY(0.f, 0.f);
+    state.ResumeTiming();
+    traits.computeVertices();
+    nVertices = tf.getPrimaryVerticesNum();
+  }
+  state.counters["vertices"] = nVertices;
+  state.SetItemsProcessed(state.iterations() * nRofs);
+}
+
+BENCHMARK(BM_ComputeVertices)->Args({1, 1})->Args({2, 1})->Args({4, 1})->Args({8, 1})->Args({1, 5})->Args({2, 5})->Args({4, 5})->Args({8, 5})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
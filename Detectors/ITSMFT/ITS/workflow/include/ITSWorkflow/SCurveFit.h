@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   SCurveFit.h
+
+#ifndef O2_ITS_SCURVE_FIT_
+#define O2_ITS_SCURVE_FIT_
+
+#include <algorithm>
+#include <cmath>
+#include "TMath.h"
+
+namespace o2
+{
+namespace its
+{
+
+//////////////////////////////////////////////////////////////////////////////
+// Thread-safe replacement of the TH1::Fit("RQL") of the S-curve amp * (1 +- erf((x - thr) / (sqrt(2) * noise))):
+// binned Poisson likelihood in threshold and noise, minimised with Levenberg-Marquardt.
+// counts(i) is the content of the i-th of nBins bins of width binW starting from xLow, only the bins
+// with the centre in [xMin, xMax] are used as for the "R" option. flip selects the falling S-curve.
+// thr and noise hold the starting values.
+// chi2 is the likelihood chi2 (Baker-Cousins), as returned by TF1::GetChisquare after a likelihood fit.
+template <typename Counts>
+bool fitSCurve(const Counts& counts, int nBins, double xLow, double binW, double xMin, double xMax, double amp, bool flip,
+               double& thr, double& noise, double& chi2, int& ndf)
+{
+  constexpr int MaxIterations = 100;
+  constexpr double MinModel = 1e-9, Tolerance = 1e-8, MaxLambda = 1e10;
+  int first = std::max(0, int(std::ceil((xMin - xLow) / binW - 0.5))), last = std::min(nBins - 1, int(std::floor((xMax - xLow) / binW - 0.5)));
+  ndf = last - first + 1 - 2;
+  if (ndf <= 0 || noise <= 0) {
+    return false;
+  }
+
+  auto model = [&](double x, double p0, double p1, double* deriv) {
+    double u = (x - p0) / (TMath::Sqrt2() * p1), e = std::erf(u);
+    if (deriv) {
+      double g = (flip ? -amp : amp) * TMath::TwoOverSqrtPi() * std::exp(-u * u);
+      deriv[0] = -g / (TMath::Sqrt2() * p1);
+      deriv[1] = -g * u / p1;
+    }
+    return std::max(flip ? amp * (1. - e) : amp * (1. + e), MinModel);
+  };
+  auto deviance = [&](double p0, double p1) {
+    double dev = 0;
+    for (int i = first; i <= last; i++) {
+      double y = counts(i), f = model(xLow + (i + 0.5) * binW, p0, p1, nullptr);
+      dev += f - y + (y > 0 ? y * std::log(y / f) : 0.);
+    }
+    return 2 * dev;
+  };
+
+  double dev = deviance(thr, noise), lambda = 1e-3;
+  for (int iter = 0; iter < MaxIterations; iter++) {
+    // gradient and Fisher information of the negative log-likelihood
+    double g0 = 0, g1 = 0, h00 = 0, h01 = 0, h11 = 0, deriv[2];
+    for (int i = first; i <= last; i++) {
+      double y = counts(i), f = model(xLow + (i + 0.5) * binW, thr, noise, deriv), r = 1. - y / f;
+      g0 += r * deriv[0];
+      g1 += r * deriv[1];
+      h00 += deriv[0] * deriv[0] / f;
+      h01 += deriv[0] * deriv[1] / f;
+      h11 += deriv[1] * deriv[1] / f;
+    }
+    bool improved = false;
+    double newDev = dev;
+    for (; lambda < MaxLambda; lambda *= 10) {
+      double a00 = h00 * (1 + lambda), a11 = h11 * (1 + lambda), det = a00 * a11 - h01 * h01;
+      if (det <= 0) {
+        continue;
+      }
+      double newThr = thr - (a11 * g0 - h01 * g1) / det, newNoise = noise - (a00 * g1 - h01 * g0) / det;
+      if (newNoise > 0 && (newDev = deviance(newThr, newNoise)) <= dev) {
+        thr = newThr;
+        noise = newNoise;
+        lambda = std::max(lambda / 10, 1e-9);
+        improved = true;
+        break;
+      }
+    }
+    if (!improved) {
+      break;
+    }
+    bool converged = dev - newDev < Tolerance * (1 + newDev);
+    dev = newDev;
+    if (converged) {
+      break;
+    }
+  }
+  chi2 = dev;
+  return true;
+}
+
+} // namespace its
+} // namespace o2
+
+#endif
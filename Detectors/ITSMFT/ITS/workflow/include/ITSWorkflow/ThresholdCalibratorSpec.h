@@ -179,6 +179,7 @@ class ITSThresholdCalibrator : public Task
   // Initialize pointers for doing error function fits
   TH1F* mFitHist = nullptr;
   TF1* mFitFunction = nullptr;
+  float mFitRangeMin = 0, mFitRangeMax = 0;
 
   // Some private helper functions
   // Helper functions related to the running over data
@@ -192,11 +193,11 @@ class ITSThresholdCalibrator : public Task
 
   // Helper functions related to threshold extraction
   void initThresholdTree(bool recreate = true);
-  bool findUpperLower(std::vector<std::vector<unsigned short int>>, const short int&, short int&, short int&, bool, int);
-  bool findThreshold(const short int&, std::vector<std::vector<unsigned short int>>, const float*, short int&, float&, float&, int&, int);
-  bool findThresholdFit(const short int&, std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdDerivative(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, float&, int&, int);
-  bool findThresholdHitcounting(std::vector<std::vector<unsigned short int>>, const float*, const short int&, float&, int);
+  bool findUpperLower(const std::vector<std::vector<unsigned short int>>&, const short int&, short int&, short int&, bool, int);
+  bool findThreshold(const short int&, const std::vector<std::vector<unsigned short int>>&, const float*, short int&, float&, float&, int&, int);
+  bool findThresholdFit(const short int&, const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdDerivative(const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, float&, int&, int);
+  bool findThresholdHitcounting(const std::vector<std::vector<unsigned short int>>&, const float*, const short int&, float&, int);
   bool isScanFinished(const short int&, const short int&, const short int&);
   void findAverage(const std::array<long int, 6>&, float&, float&, float&, float&);
   void saveThreshold();
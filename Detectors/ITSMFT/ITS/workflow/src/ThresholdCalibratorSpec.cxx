@@ -12,6 +12,7 @@
 /// @file   ThresholdCalibratorSpec.cxx
 
 #include "ITSWorkflow/ThresholdCalibratorSpec.h"
+#include "ITSWorkflow/SCurveFit.h"
 #include "CommonUtils/FileSystemUtils.h"
 #include "CCDB/BasicCCDBManager.h"
 
@@ -125,11 +126,6 @@ void ITSThresholdCalibrator::init(InitContext& ic)
   // Get number of threads
   this->mNThreads = ic.options().get<int>("nthreads");
 
-  // Check fit type vs nthreads (fit option is not thread safe!)
-  if (mFitType == FIT && mNThreads > 1) {
-    throw std::runtime_error("Multiple threads are requested with fit method which is not thread safe");
-  }
-
   // Machine hostname
   this->mHostname = boost::asio::ip::host_name();
 
@@ -225,6 +221,10 @@ void ITSThresholdCalibrator::init(InitContext& ic)
   if (isDumpS && mFitType != FIT) {
     LOG(error) << "S-curve dump enabled but `fittype` is not fit. Please check";
   }
+  // Check s-curve dump vs nthreads (the dump histogram and file are shared)
+  if (isDumpS && mNThreads > 1) {
+    throw std::runtime_error("Multiple threads are requested with s-curve dump which is not thread safe");
+  }
   if (isDumpS) {
     fileDumpS = TFile::Open(Form("s-curves_%d.root", mChipModSel), "RECREATE"); // in case of multiple processes, every process will have it's own file
     if (maxDumpS < 0) {
@@ -422,7 +422,7 @@ void ITSThresholdCalibrator::initThresholdTree(bool recreate /*=true*/)
 // x is the array of charge injected values;
 // NPoints is the length of both arrays.
 bool ITSThresholdCalibrator::findUpperLower(
-  std::vector<std::vector<unsigned short int>> data, const short int& NPoints,
+  const std::vector<std::vector<unsigned short int>>& data, const short int& NPoints,
   short int& lower, short int& upper, bool flip, int iloop2)
 {
   // Initialize (or re-initialize) upper and lower
@@ -482,7 +482,7 @@ bool ITSThresholdCalibrator::findUpperLower(
 //////////////////////////////////////////////////////////////////////////////
 // Main findThreshold function which calls one of the three methods
 bool ITSThresholdCalibrator::findThreshold(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, short int& NPoints,
+  const short int& chipID, const std::vector<std::vector<unsigned short int>>& data, const float* x, short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   bool success = false;
@@ -514,7 +514,7 @@ bool ITSThresholdCalibrator::findThreshold(
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdFit(
-  const short int& chipID, std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+  const short int& chipID, const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints,
   float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -550,32 +550,32 @@ bool ITSThresholdCalibrator::findThresholdFit(
     return false;
   }
 
-  for (int i = 0; i < NPoints; i++) {
-    this->mFitHist->SetBinContent(i + 1, mScanType != 'r' ? data[iloop2][i] : data[i][iloop2]);
-  }
-
-  // Initialize starting parameters
-  this->mFitFunction->SetParameter(0, start);
-  this->mFitFunction->SetParameter(1, 8);
+  // Fit the S-curve in the same bins and range as the TH1 / TF1 of the dumps, reading the counts in place
+  auto counts = [&](int i) -> double { return mScanType != 'r' ? data[iloop2][i] : data[i][iloop2]; };
+  double fitThr = start, fitNoise = 8, chi2 = 0;
+  int ndf = 0;
+  bool fitted = fitSCurve(counts, NPoints, this->mX[0] - 1., (this->mX[NPoints - 1] - this->mX[0] + 1.) / NPoints, mFitRangeMin, mFitRangeMax, nInjScaled / 2, flip, fitThr, fitNoise, chi2, ndf);
 
-  this->mFitHist->Fit("mFitFunction", "RQL");
   if (isDumpS && (dumpCounterS[chipID] < maxDumpS || maxDumpS < 0) && (fndVal != chipDumpList.end() || !chipDumpList.size())) { // save good s-curves
+    for (int i = 0; i < NPoints; i++) {
+      this->mFitHist->SetBinContent(i + 1, counts(i));
+    }
+    this->mFitFunction->SetParameters(fitThr, fitNoise);
+    this->mFitHist->GetListOfFunctions()->Add(this->mFitFunction->Clone());
     fileDumpS->cd();
     mFitHist->Write();
+    // Clean up histogram for next time it is used
+    this->mFitHist->Reset();
   }
   if (isDumpS) {
     dumpCounterS[chipID]++;
   }
 
-  noise = this->mFitFunction->GetParameter(1);
-  thresh = this->mFitFunction->GetParameter(0);
-  float chi2 = this->mFitFunction->GetChisquare() / this->mFitFunction->GetNDF();
+  noise = fitNoise;
+  thresh = fitThr;
   spoints = upper - lower - 1;
 
-  // Clean up histogram for next time it is used
-  this->mFitHist->Reset();
-
-  return (chi2 < 5);
+  return fitted && (chi2 / ndf < 5);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -585,7 +585,7 @@ bool ITSThresholdCalibrator::findThresholdFit(
 // NPoints is the length of both arrays.
 // spoints: number of points in the S of the S-curve (with n_hits between 0 and 50, excluding first and last point)
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
-bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints,
+bool ITSThresholdCalibrator::findThresholdDerivative(const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints,
                                                      float& thresh, float& noise, int& spoints, int iloop2)
 {
   // Find lower & upper values of the S-curve region
@@ -631,7 +631,7 @@ bool ITSThresholdCalibrator::findThresholdDerivative(std::vector<std::vector<uns
 // NPoints is the length of both arrays.
 // iloop2 is 0 for thr scan but is equal to vresetd index in 2D vresetd scan
 bool ITSThresholdCalibrator::findThresholdHitcounting(
-  std::vector<std::vector<unsigned short int>> data, const float* x, const short int& NPoints, float& thresh, int iloop2)
+  const std::vector<std::vector<unsigned short int>>& data, const float* x, const short int& NPoints, float& thresh, int iloop2)
 {
   unsigned short int numberOfHits = 0;
   bool is50 = false;
@@ -754,6 +754,7 @@ void ITSThresholdCalibrator::extractThresholdRow(const short int& chipID, const
 
     for (int scan_i = 0; scan_i < ((mScanType == 'r') ? N_RANGE : N_RANGE2); scan_i++) {
 
+      const auto& rowHits = mPixelHits[chipID][row]; // no map lookups in the parallel loop
 #ifdef WITH_OPENMP
       omp_set_num_threads(mNThreads);
 #pragma omp parallel for schedule(dynamic)
@@ -769,7 +770,7 @@ void ITSThresholdCalibrator::extractThresholdRow(const short int& chipID, const
           mFitHist->SetName(Form("scurve_chip%d_row%d_col%d_scani%d", chipID, row, col_i, scan_i));
         }
 
-        success = this->findThreshold(chipID, mPixelHits[chipID][row][col_i],
+        success = this->findThreshold(chipID, rowHits[col_i],
                                       this->mX, mScanType == 'r' ? N_RANGE2 : N_RANGE, thresh, noise, spoints, scan_i);
 
         vChipid[col_i] = chipID;
@@ -1092,10 +1093,12 @@ void ITSThresholdCalibrator::setRunType(const short int& runtype)
     this->mFitHist = new TH1F(
       "mFitHist", "mFitHist", mScanType == 'r' ? N_RANGE2 : N_RANGE, mX[0] - 1., mX[(mScanType == 'r' ? N_RANGE2 : N_RANGE) - 1]);
 
-    // Initialize correct fit function for the scan type
+    // Initialize correct fit range and function (only used to dump the s-curves) for the scan type
+    this->mFitRangeMin = (mScanType == 'T' || mScanType == 'r') ? 3 : mMin;
+    this->mFitRangeMax = mScanType == 'r' ? mMax2 : mMax;
     this->mFitFunction = (this->mScanType == 'I')
-                           ? new TF1("mFitFunction", erf_ithr, mMin, mMax, 2)
-                           : new TF1("mFitFunction", erf, (mScanType == 'T' || mScanType == 'r') ? 3 : mMin, mScanType == 'r' ? mMax2 : mMax, 2);
+                           ? new TF1("mFitFunction", erf_ithr, mFitRangeMin, mFitRangeMax, 2)
+                           : new TF1("mFitFunction", erf, mFitRangeMin, mFitRangeMax, 2);
     this->mFitFunction->SetParName(0, "Threshold");
     this->mFitFunction->SetParName(1, "Noise");
   }
@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test ITS SCurveFit
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <random>
+#include "TH1F.h"
+#include "TF1.h"
+#include "ITSWorkflow/SCurveFit.h"
+
+using namespace o2::its;
+
+// fitSCurve must find the same threshold, noise and chi2/NDF as the likelihood fit of ROOT it replaces,
+// for the rising S-curves of the threshold scans and the falling ones of the ITHR scans
+BOOST_AUTO_TEST_CASE(SCurveFit_CompareToROOT)
+{
+  constexpr int NInj = 50, NPoints = 50, NCurves = 200;
+  constexpr double Amp = NInj / 2, XMin = 3, XMax = NPoints - 1;
+  const double xLow = -1., binW = 1.; // as the TH1F of the calibrator for the charges 0..NPoints-1
+  std::mt19937 gen(4242);
+  std::uniform_real_distribution<double> thrGen(10, 35), noiseGen(1.5, 8);
+
+  for (bool flip : {false, true}) {
+    TH1F hist(flip ? "scurve_ithr" : "scurve_thr", "", NPoints, xLow, xLow + NPoints * binW);
+    TF1 func("func", [flip](double* x, double* par) { return Amp * (1 + (flip ? -1 : 1) * TMath::Erf((x[0] - par[0]) / (std::sqrt(2) * par[1]))); }, XMin, XMax, 2);
+    for (int ic = 0; ic < NCurves; ic++) {
+      double thrTrue = thrGen(gen), noiseTrue = noiseGen(gen);
+      for (int i = 0; i < NPoints; i++) {
+        double x = hist.GetBinCenter(i + 1);
+        double p = 0.5 * (1 + (flip ? -1 : 1) * std::erf((x - thrTrue) / (std::sqrt(2) * noiseTrue)));
+        hist.SetBinContent(i + 1, std::binomial_distribution<int>(NInj, p)(gen));
+      }
+      const double thrStart = thrTrue + 3, noiseStart = 8;
+
+      func.SetParameters(thrStart, noiseStart);
+      hist.Fit(&func, "RQLN");
+      double thrROOT = func.GetParameter(0), noiseROOT = func.GetParameter(1);
+      double chi2NdfROOT = func.GetChisquare() / func.GetNDF();
+
+      double thr = thrStart, noise = noiseStart, chi2 = 0;
+      int ndf = 0;
+      auto counts = [&hist](int i) -> double { return hist.GetBinContent(i + 1); };
+      BOOST_REQUIRE(fitSCurve(counts, NPoints, xLow, binW, XMin, XMax, Amp, flip, thr, noise, chi2, ndf));
+      BOOST_CHECK_EQUAL(ndf, func.GetNDF());
+      BOOST_CHECK_SMALL(thr - thrROOT, 0.02);
+      BOOST_CHECK_SMALL(std::abs(noise) - std::abs(noiseROOT), 0.02);
+      BOOST_CHECK_SMALL(chi2 / ndf - chi2NdfROOT, 0.01 * (1 + chi2NdfROOT));
+    }
+  }
+}
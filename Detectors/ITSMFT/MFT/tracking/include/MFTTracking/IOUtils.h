@@ -67,6 +67,10 @@ int loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe<T>& events, gsl::s
                     const dataformats::MCTruthContainer<MCCompLabel>* mClsLabels, const o2::mft::Tracker<T>* tracker,
                     ROFFilter& filter);
 
+/// position in the patterns stream of the first pattern of every ROF, allowing to load the ROFs independently
+std::vector<gsl::span<const unsigned char>::iterator> getROFPatternStarts(gsl::span<const o2::itsmft::ROFRecord> rofs, gsl::span<const itsmft::CompClusterExt> clusters,
+                                                                          gsl::span<const unsigned char> patterns, const itsmft::TopologyDictionary* dict);
+
 void convertCompactClusters(gsl::span<const itsmft::CompClusterExt> clusters,
                             gsl::span<const unsigned char>::iterator& pattIt,
                             std::vector<o2::BaseCluster<float>>& output,
@@ -106,6 +106,25 @@ int ioutils::loadROFrameData(const o2::itsmft::ROFRecord& rof, ROframe<T>& event
   return nClusters;
 }
 
+//_________________________________________________________
+std::vector<gsl::span<const unsigned char>::iterator> ioutils::getROFPatternStarts(gsl::span<const o2::itsmft::ROFRecord> rofs, gsl::span<const itsmft::CompClusterExt> clusters,
+                                                                                   gsl::span<const unsigned char> patterns, const itsmft::TopologyDictionary* dict)
+{
+  std::vector<gsl::span<const unsigned char>::iterator> starts;
+  starts.reserve(rofs.size());
+  auto pattIt = patterns.begin();
+  for (const auto& rof : rofs) {
+    starts.push_back(pattIt);
+    for (const auto& c : rof.getROFData(clusters)) {
+      auto pattID = c.getPatternID();
+      if (pattID == itsmft::CompCluster::InvalidPatternID || dict->isGroup(pattID)) { // same clusters as consuming a pattern in loadROFrameData
+        o2::itsmft::ClusterPattern::skipPattern(pattIt);
+      }
+    }
+  }
+  return starts;
+}
+
 //_________________________________________________________
 /// convert compact clusters to 3D spacepoints into std::vector<o2::BaseCluster<float>>
 void ioutils::convertCompactClusters(gsl::span<const itsmft::CompClusterExt> clusters,
@@ -66,15 +66,15 @@ class TrackerDPL : public o2::framework::Task
   enum TimerIDs { SWTot,
                   SWLoadData,
                   SWFindMFTTracks,
-                  SWFitTracks,
                   SWComputeLabels,
                   NStopWatches };
   static constexpr std::string_view TimerName[] = {"TotalProcessing",
                                                    "LoadData",
-                                                   "FindTracks",
-                                                   "FitTracks",
+                                                   "FindFitTracks",
                                                    "ComputeLabels"};
   TStopwatch mTimer[NStopWatches];
+  std::vector<long> mWorkerROFs;   ///< number of ROFs processed by every tracking worker
+  std::vector<double> mWorkerTime; ///< busy time of every tracking worker, in s
 
   ROFFilter createIRFrameFilter(gsl::span<const o2::dataformats::IRFrame> irframes)
   {
@@ -19,6 +19,8 @@
 #include "MFTTracking/TrackCA.h"
 #include "MFTBase/GeometryTGeo.h"
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <future>
 
@@ -53,6 +55,8 @@ void TrackerDPL::init(InitContext& ic)
     mTimer[sw].Stop();
     mTimer[sw].Reset();
   }
+  mWorkerROFs.assign(mNThreads, 0);
+  mWorkerTime.assign(mNThreads, 0.);
 
   // tracking configuration parameters
   auto& trackingParam = MFTTrackingParam::Instance(); // to avoid loading interpreter during the run
@@ -111,83 +115,61 @@ void TrackerDPL::run(ProcessingContext& pc)
   std::vector<o2::mft::TrackLTFL> tracksL;
   auto& allTracksMFT = pc.outputs().make<std::vector<o2::mft::TrackMFT>>(Output{"MFT", "TRACKS", 0});
 
-  std::uint32_t roFrameId = 0;
   int nROFs = rofs.size();
-  auto rofsPerWorker = std::max(1, nROFs / mNThreads);
-  LOG(debug) << "nROFs = " << nROFs << " rofsPerWorker = " << rofsPerWorker;
-
-  auto loadData = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    auto& tracker = trackerVec[0]; // Use first tracker to load the data: serial operation
-    gsl::span<const unsigned char>::iterator pattIt = patterns.begin();
-
-    auto iROF = 0;
-
-    for (const auto& rof : rofs) {
-      int worker = std::min(int(iROF / rofsPerWorker), mNThreads - 1);
-      auto& roFrameData = roFrameDataVec[worker].emplace_back();
-      int nclUsed = ioutils::loadROFrameData(rof, roFrameData, compClusters, pattIt, mDict, labels, tracker.get(), filter);
-      LOG(debug) << "ROframeId: " << iROF << ", clusters loaded : " << nclUsed << " on worker " << worker;
-      iROF++;
-    }
-  };
-
-  auto launchTrackFinder = [](auto* tracker, auto* workerROFs) {
-#ifdef _TIMING_
-    long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count(), tStartROF = tStart, tEnd = tStart;
-    size_t rofCNT = 0;
-#endif
-    for (auto& rofData : *workerROFs) {
-      tracker->findTracks(rofData);
-#ifdef _TIMING_
-      long tEndROF = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-      LOGP(info, "launchTrackFinder| tracker:{} did {}-th ROF in {} mus: {} clusters -> {} tracks", tracker->getTrackerID(), ++rofCNT, tEndROF - tStartROF, rofData.getTotalClusters(), rofData.getTracks().size());
-      tStartROF = tEnd = tEndROF;
-#endif
-    }
-#ifdef _TIMING_
-    LOGP(info, "launchTrackFinder| done: tracker:{} processed {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
-#endif
-  };
-
-  auto launchFitter = [](auto* tracker, auto* workerROFs) {
-#ifdef _TIMING_
-    long tStart = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-#endif
-    for (auto& rofData : *workerROFs) {
-      tracker->fitTracks(rofData);
-    }
+  LOG(debug) << "nROFs = " << nROFs << " on " << mNThreads << " threads";
+
+  // The ROFs are distributed dynamically: every worker pulls the next unprocessed ROF, loads its clusters and finds and fits its tracks,
+  // so that a few busy ROFs do not stall the TF. The only serial step is locating the patterns of every ROF in the patterns stream.
+  mTimer[SWLoadData].Start(false);
+  o2::mft::GeometryTGeo::Instance()->fillMatrixCache(o2::math_utils::bit2Mask(o2::math_utils::TransformType::T2L, o2::math_utils::TransformType::L2G));
+  auto pattStarts = ioutils::getROFPatternStarts(rofs, compClusters, patterns, mDict);
+  mTimer[SWLoadData].Stop();
+
+  auto runTracking = [&, this](auto& trackerVec, auto& roFrameData) {
+    std::atomic<int> nextROF{0};
+    std::vector<int> workerROFs(mNThreads, 0);
+    std::vector<double> workerTime(mNThreads, 0.);
+    auto launchTracking = [&](int worker) {
+      auto tStart = std::chrono::steady_clock::now();
+      auto* tracker = trackerVec[worker].get();
+      int iROF;
+      while ((iROF = nextROF++) < nROFs) {
+        auto pattIt = pattStarts[iROF];
+        auto& event = roFrameData[iROF];
+        [[maybe_unused]] int nclUsed = ioutils::loadROFrameData(rofs[iROF], event, compClusters, pattIt, mDict, labels, tracker, filter);
+        tracker->findTracks(event);
+        tracker->fitTracks(event);
+        workerROFs[worker]++;
 #ifdef _TIMING_
-    long tEnd = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
-    LOGP(info, "launchTrackFitter| done: tracker:{} fitted  {} ROFS in {} mus", tracker->getTrackerID(), workerROFs->size(), tEnd - tStart);
+        LOGP(info, "launchTracking| tracker:{} did ROF {}: {} clusters -> {} tracks", tracker->getTrackerID(), iROF, nclUsed, event.getTracks().size());
 #endif
-  };
-
-  auto runMFTTrackFinder = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    std::vector<std::future<void>> finder;
+      }
+      workerTime[worker] = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    };
+    std::vector<std::future<void>> workers;
     for (int i = 0; i < mNThreads; i++) {
-      auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchTrackFinder, tracker.get(), &workerData);
-      finder.push_back(std::move(f));
+      workers.push_back(std::async(std::launch::async, launchTracking, i));
     }
-
-    for (int i = 0; i < mNThreads; i++) {
-      finder[i].wait();
+    for (auto& w : workers) {
+      w.wait();
     }
-  };
-
-  auto runTrackFitter = [&, this](auto& trackerVec, auto& roFrameDataVec) {
-    std::vector<std::future<void>> fitter;
     for (int i = 0; i < mNThreads; i++) {
-      auto& tracker = trackerVec[i];
-      auto& workerData = roFrameDataVec[i];
-      auto f = std::async(std::launch::async, launchFitter, tracker.get(), &workerData);
-      fitter.push_back(std::move(f));
+      LOGP(debug, "MFTTracker worker {} processed {} ROFs in {:.3f} s", i, workerROFs[i], workerTime[i]);
+      mWorkerROFs[i] += workerROFs[i];
+      mWorkerTime[i] += workerTime[i];
     }
+  };
 
-    for (int i = 0; i < mNThreads; i++) {
-      fitter[i].wait();
+  auto computeLabels = [&](auto& tracker, auto& roFrameData) {
+    LOG(debug) << "Computing MC Labels.";
+    mTimer[SWComputeLabels].Start(false);
+    for (auto& rofData : roFrameData) {
+      tracker->computeTracksMClabels(rofData.getTracks());
+      trackLabels.swap(tracker->getTrackLabels());
+      std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
+      trackLabels.clear();
     }
+    mTimer[SWComputeLabels].Stop();
   };
 
   // snippet to convert found tracks to final output tracks with separate cluster indices
@@ -206,122 +188,43 @@ void TrackerDPL::run(ProcessingContext& pc)
     }
   };
 
-  if (mFieldOn) {
-
-    std::vector<std::vector<o2::mft::ROframe<TrackLTF>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
+  // the output is assembled in the ROF order, independently of which worker processed the ROF
+  auto storeTracks = [&](auto& roFrameData, auto& roFrameTracks) {
+    for (int iROF = 0; iROF < nROFs; iROF++) {
+      int firstROFTrackEntry = allTracksMFT.size();
+      roFrameTracks.swap(roFrameData[iROF].getTracks());
+      copyTracks(roFrameTracks, allTracksMFT, allClusIdx);
+      rofs[iROF].setFirstEntry(firstROFTrackEntry);
+      rofs[iROF].setNEntries(roFrameTracks.size());
+      roFrameTracks.clear();
     }
-    LOG(debug) << "Loading data into ROFs.";
+  };
 
-    mTimer[SWLoadData].Start(false);
-    loadData(mTrackerVec, roFrameVec);
-    mTimer[SWLoadData].Stop();
+  if (mFieldOn) {
+    std::vector<o2::mft::ROframe<TrackLTF>> roFrameData(nROFs);
 
     LOG(debug) << "Running MFT Track finder.";
-
     mTimer[SWFindMFTTracks].Start(false);
-    runMFTTrackFinder(mTrackerVec, roFrameVec);
+    runTracking(mTrackerVec, roFrameData);
     mTimer[SWFindMFTTracks].Stop();
 
-    LOG(debug) << "Runnig track fitter.";
-
-    mTimer[SWFitTracks].Start(false);
-    runTrackFitter(mTrackerVec, roFrameVec);
-    mTimer[SWFitTracks].Stop();
-
     if (mUseMC) {
-      LOG(debug) << "Computing MC Labels.";
-
-      mTimer[SWComputeLabels].Start(false);
-      auto& tracker = mTrackerVec[0];
-
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
-      }
-      mTimer[SWComputeLabels].Stop();
+      computeLabels(mTrackerVec[0], roFrameData);
     }
-
-    auto rof = rofs.begin();
-
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracks.swap(rofData.getTracks());
-        ntracksROF = tracks.size();
-        copyTracks(tracks, allTracksMFT, allClusIdx);
-
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
-    }
-
+    storeTracks(roFrameData, tracks);
   } else {
     LOG(debug) << "Field is off! ";
-    std::vector<std::vector<o2::mft::ROframe<TrackLTFL>>> roFrameVec(mNThreads); // One vector of ROFrames per thread
-    LOG(debug) << "Reserving ROFs ";
-
-    for (auto& rof : roFrameVec) {
-      rof.reserve(rofsPerWorker);
-    }
-    LOG(debug) << "Loading data into ROFs.";
-
-    mTimer[SWLoadData].Start(false);
-    loadData(mTrackerLVec, roFrameVec);
-    mTimer[SWLoadData].Stop();
+    std::vector<o2::mft::ROframe<TrackLTFL>> roFrameData(nROFs);
 
     LOG(debug) << "Running MFT Track finder.";
-
     mTimer[SWFindMFTTracks].Start(false);
-    runMFTTrackFinder(mTrackerLVec, roFrameVec);
+    runTracking(mTrackerLVec, roFrameData);
     mTimer[SWFindMFTTracks].Stop();
 
-    LOG(debug) << "Runnig track fitter.";
-
-    mTimer[SWFitTracks].Start(false);
-    runTrackFitter(mTrackerLVec, roFrameVec);
-    mTimer[SWFitTracks].Stop();
-
     if (mUseMC) {
-      LOG(debug) << "Computing MC Labels.";
-
-      mTimer[SWComputeLabels].Start(false);
-      auto& tracker = mTrackerLVec[0];
-
-      for (int i = 0; i < mNThreads; i++) {
-        for (auto& rofData : roFrameVec[i]) {
-          tracker->computeTracksMClabels(rofData.getTracks());
-          trackLabels.swap(tracker->getTrackLabels());
-          std::copy(trackLabels.begin(), trackLabels.end(), std::back_inserter(allTrackLabels));
-          trackLabels.clear();
-        }
-      }
-      mTimer[SWComputeLabels].Stop();
-    }
-
-    auto rof = rofs.begin();
-
-    for (int i = 0; i < mNThreads; i++) {
-      for (auto& rofData : roFrameVec[i]) {
-        int ntracksROF = 0, firstROFTrackEntry = allTracksMFT.size();
-        tracksL.swap(rofData.getTracks());
-        ntracksROF = tracksL.size();
-        copyTracks(tracksL, allTracksMFT, allClusIdx);
-        rof->setFirstEntry(firstROFTrackEntry);
-        rof->setNEntries(ntracksROF);
-        *rof++;
-        roFrameId++;
-      }
+      computeLabels(mTrackerLVec[0], roFrameData);
     }
+    storeTracks(roFrameData, tracksL);
   }
 
   LOG(info) << "MFTTracker pushed " << allTracksMFT.size() << " tracks";
@@ -339,6 +242,9 @@ void TrackerDPL::endOfStream(EndOfStreamContext& ec)
   for (int i = 0; i < NStopWatches; i++) {
     LOGF(info, "Timing %18s: Cpu: %.3e s; Real: %.3e s in %d slots", TimerName[i], mTimer[i].CpuTime(), mTimer[i].RealTime(), mTimer[i].Counter() - 1);
   }
+  for (int i = 0; i < mNThreads; i++) {
+    LOGF(info, "Tracking worker %2d: %8ld ROFs in %.3e s", i, mWorkerROFs[i], mWorkerTime[i]);
+  }
 }
 ///_______________________________________
 void TrackerDPL::updateTimeDependentParams(ProcessingContext& pc)
@@ -16,7 +16,7 @@
 #include <cstdint>
 #include <vector>
 #include <string>
-#include <cstdint>
+#include <array>
 #include "Framework/Logger.h"
 #include "PayLoadCont.h"
 #include <map>
@@ -106,6 +106,37 @@ class AlpideCoder
   static constexpr uint32_t BUSYOFF = 0xf0;     // flag for BUSY_OFF
   static constexpr uint32_t BUSYON = 0xf1;      // flag for BUSY_ON
 
+  /// pixels encoded in the hit map of a DATALONG, in the decoding order, relative to the DATALONG pixel
+  struct DataLongHits {
+    uint8_t nHits = 0;
+    uint8_t maxAddrOffset = 0;          // offset of the last pixel address w.r.t. the DATALONG address
+    uint8_t rowOffset[HitMapSize] = {}; // row w.r.t. the row of the DATALONG pixel
+    bool rightCol[HitMapSize] = {};     // true for the right column of the double column
+  };
+  /// hit map expansion table, indexed by the 2 lowest bits of the DATALONG address and by the hit map
+  using DataLongTable = std::array<std::array<DataLongHits, MaskHitMap + 1>, 4>;
+
+  static constexpr DataLongTable makeDataLongTable()
+  {
+    DataLongTable table{};
+    for (int low = 0; low < 4; low++) {
+      for (int map = 0; map <= int(MaskHitMap); map++) {
+        auto& hits = table[low][map];
+        for (int ip = 0; ip < HitMapSize; ip++) {
+          if (map & (0x1 << ip)) {
+            int addr = low + ip + 1, rowE = addr >> 1; // same as in the bit by bit decoding
+            hits.rowOffset[hits.nHits] = rowE - (low >> 1);
+            hits.rightCol[hits.nHits] = (rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1);
+            hits.maxAddrOffset = ip + 1;
+            hits.nHits++;
+          }
+        }
+      }
+    }
+    return table;
+  }
+  static const DataLongTable DataLongLUT;
+
   // true if corresponds to DATALONG or DATASHORT: highest bit must be 0
   static bool isData(uint16_t v) { return (v & (0x1 << 15)) == 0; }
   static bool isData(uint8_t v) { return (v & (0x1 << 7)) == 0; }
@@ -245,9 +276,7 @@ class AlpideCoder
         // in case there are entries in the "right" columns buffer, add them to the container
         if (nRightCHits) {
           colDPrev++;
-          for (int ihr = 0; ihr < nRightCHits; ihr++) {
-            addHit(chipData, rightColHits[ihr], colDPrev);
-          }
+          addHits(chipData, rightColHits, nRightCHits, colDPrev);
         }
 
         if (!dataSeen && !chipData.isErrorSet()) {
@@ -293,9 +322,7 @@ class AlpideCoder
               needSorting = true;                         // effectively disabled
             }
             colDPrev++;
-            for (int ihr = 0; ihr < nRightCHits; ihr++) {
-              addHit(chipData, rightColHits[ihr], colDPrev);
-            }
+            addHits(chipData, rightColHits, nRightCHits, colDPrev);
             colDPrev = colD;
             nRightCHits = 0; // reset the buffer
 #ifdef ALPIDE_DECODING_STAT
@@ -348,6 +375,18 @@ class AlpideCoder
 #endif
               return unexpectedEOF("CHIP_DATA_LONG:Pattern"); // abandon cable data
             }
+            const auto& hits = DataLongLUT[pixID & 0x3][hitsPattern];
+            if (pixID + hits.maxAddrOffset <= MaskPixID) { // all addresses are valid, expand the hit map via the table
+              uint16_t row0 = pixID >> 1;
+              for (int ih = 0; ih < hits.nHits; ih++) {
+                if (hits.rightCol[ih]) {
+                  rightColHits[nRightCHits++] = row0 + hits.rowOffset[ih];
+                } else {
+                  addHit(chipData, row0 + hits.rowOffset[ih], colD);
+                }
+              }
+              hitsPattern = 0; // nothing left for the bit by bit decoding below
+            }
             for (int ip = 0; ip < HitMapSize; ip++) {
               if (hitsPattern & (0x1 << ip)) {
                 uint16_t addr = pixID + ip + 1, rowE = addr >> 1;
@@ -482,6 +521,25 @@ class AlpideCoder
     chipData.getData().emplace_back(row, col);
   }
 
+  /// Output the non-noisy fired pixels among nHits rows of the same column
+  static void addHits(ChipPixelData& chipData, const uint16_t* rows, int nHits, short col)
+  {
+    auto& pixels = chipData.getData();
+    if (mNoisyPixels) {
+      auto chipID = chipData.getChipID();
+      for (int ih = 0; ih < nHits; ih++) {
+        if (!mNoisyPixels->isNoisy(chipID, rows[ih], col)) {
+          pixels.emplace_back(rows[ih], col);
+        }
+      }
+    } else {
+      for (int ih = 0; ih < nHits; ih++) {
+        pixels.emplace_back(rows[ih], col);
+      }
+    }
+    LOGP(debug, "Added {} hits at c:{} of chip:{}, {} hits in total", nHits, col, chipData.getChipID(), pixels.size());
+  }
+
   ///< add pixed to compressed matrix, the data must be provided sorted in row/col, no check is done
   void addPixel(short row, short col)
   {
@@ -17,6 +17,7 @@
 using namespace o2::itsmft;
 
 const NoiseMap* AlpideCoder::mNoisyPixels = nullptr;
+const AlpideCoder::DataLongTable AlpideCoder::DataLongLUT = AlpideCoder::makeDataLongTable();
 
 //_____________________________________
 void AlpideCoder::print() const
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief single core throughput of AlpideCoder::decodeChip
+// The chips are filled with random clusters and encoded with AlpideCoder::encodeChip,
+// the correctness of the decoding is checked by testAlpideCoder.
+// If the O2_ITSMFT_ALPIDE_PAYLOAD_FILE environment variable is set, the file is expected to contain
+// the concatenated ALPIDE data of a cable (i.e. the GBT payload stripped of the GBT words)
+// and is decoded instead.
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+constexpr int NChips = 1000;
+
+// fill NChips chips with clusters of up to maxClusSize pixels
+void createInput(int nClusPerChip, int maxClusSize, std::vector<ChipPixelData>& chips, PayLoadCont& buffer)
+{
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rowGen(0, AlpideCoder::NRows - 1), colGen(0, AlpideCoder::NCols - 1);
+  std::uniform_int_distribution<int> sizeGen(1, maxClusSize), offsGen(0, 3);
+  AlpideCoder coder;
+  chips.resize(NChips);
+  std::vector<std::pair<short, short>> pixels; // row, col
+  for (int ic = 0; ic < NChips; ic++) {
+    pixels.clear();
+    for (int icl = 0; icl < nClusPerChip; icl++) {
+      int row = rowGen(gen), col = colGen(gen), size = sizeGen(gen);
+      for (int ip = 0; ip < size; ip++) {
+        pixels.emplace_back(std::min(row + offsGen(gen), AlpideCoder::NRows - 1), std::min(col + offsGen(gen), AlpideCoder::NCols - 1));
+      }
+    }
+    std::sort(pixels.begin(), pixels.end());
+    pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+    chips[ic].setChipID(ic % 9);
+    for (const auto& pix : pixels) {
+      chips[ic].getData().emplace_back(pix.first, pix.second);
+    }
+    buffer.ensureFreeCapacity(40 * (2 + pixels.size())); // make sure buffer has enough capacity
+    coder.encodeChip(buffer, chips[ic], ic % 9, 0);
+  }
+}
+
+bool readInput(const char* fileName, PayLoadCont& buffer)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in.good()) {
+    return false;
+  }
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  buffer.add(data.data(), data.size());
+  return !data.empty();
+}
+
+// decode the whole buffer, return the number of pixels
+size_t decodeAll(PayLoadCont& buffer, ChipPixelData& chip, std::vector<uint16_t>& seenChips)
+{
+  size_t nPixels = 0;
+  buffer.rewind();
+  while (AlpideCoder::decodeChip(chip, buffer, seenChips, [](uint16_t chipIDLoc) { return chipIDLoc; }) > 0) {
+    nPixels += chip.getData().size();
+    seenChips.clear();
+  }
+  return nPixels;
+}
+
+// state.range: 0 - number of clusters per chip, 1 - max cluster size
+static void BM_DecodeChip(benchmark::State& state)
+{
+  PayLoadCont buffer;
+  ChipPixelData chip;
+  std::vector<uint16_t> seenChips;
+  const char* fileName = std::getenv("O2_ITSMFT_ALPIDE_PAYLOAD_FILE");
+  if (!fileName || !readInput(fileName, buffer)) {
+    buffer.clear();
+    std::vector<ChipPixelData> input;
+    createInput(state.range(0), state.range(1), input, buffer);
+  }
+  size_t nPixels = 0;
+  for (auto _ : state) {
+    nPixels += decodeAll(buffer, chip, seenChips);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.getSize());
+  state.SetItemsProcessed(nPixels);
+}
+
+BENCHMARK(BM_DecodeChip)->Args({5, 4})->Args({20, 8})->Args({50, 16})->Args({100, 32})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AlpideCoder
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+// the table driven DATALONG expansion must give the same pixels as the bit by bit decoding
+BOOST_AUTO_TEST_CASE(AlpideCoder_DataLongLUT)
+{
+  int nChecked = 0;
+  for (uint32_t pixID = 0; pixID <= AlpideCoder::MaskPixID; pixID++) {
+    for (uint32_t map = 0; map <= AlpideCoder::MaskHitMap; map++) {
+      const auto& hits = AlpideCoder::DataLongLUT[pixID & 0x3][map];
+      if (pixID + hits.maxAddrOffset > AlpideCoder::MaskPixID) {
+        continue; // decoded bit by bit
+      }
+      int ih = 0;
+      for (int ip = 0; ip < AlpideCoder::HitMapSize; ip++) {
+        if (!(map & (0x1 << ip))) {
+          continue;
+        }
+        uint32_t addr = pixID + ip + 1, rowE = addr >> 1;
+        bool rightC = (rowE & 0x1) ? !(addr & 0x1) : (addr & 0x1);
+        BOOST_REQUIRE(ih < hits.nHits);
+        BOOST_CHECK_EQUAL((pixID >> 1) + hits.rowOffset[ih], rowE);
+        BOOST_CHECK_EQUAL(hits.rightCol[ih], rightC);
+        ih++;
+      }
+      BOOST_CHECK_EQUAL(ih, hits.nHits);
+      nChecked++;
+    }
+  }
+  BOOST_CHECK(nChecked > 0);
+}
+
+// encoded chips must be decoded to the same pixels, for sparse and for dense clusters
+BOOST_AUTO_TEST_CASE(AlpideCoder_RoundTrip)
+{
+  constexpr int NChips = 500;
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rowGen(0, AlpideCoder::NRows - 1), colGen(0, AlpideCoder::NCols - 1);
+  std::uniform_int_distribution<int> nClusGen(1, 100), sizeGen(1, 32), offsGen(0, 3);
+  AlpideCoder coder;
+  PayLoadCont buffer;
+  std::vector<ChipPixelData> input(NChips);
+  std::vector<std::pair<short, short>> pixels; // row, col
+  for (int ic = 0; ic < NChips; ic++) {
+    pixels.clear();
+    int nClus = nClusGen(gen);
+    for (int icl = 0; icl < nClus; icl++) {
+      int row = rowGen(gen), col = colGen(gen), size = sizeGen(gen);
+      for (int ip = 0; ip < size; ip++) {
+        pixels.emplace_back(std::min(row + offsGen(gen), AlpideCoder::NRows - 1), std::min(col + offsGen(gen), AlpideCoder::NCols - 1));
+      }
+    }
+    std::sort(pixels.begin(), pixels.end());
+    pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+    input[ic].setChipID(ic % 9);
+    for (const auto& pix : pixels) {
+      input[ic].getData().emplace_back(pix.first, pix.second);
+    }
+    buffer.ensureFreeCapacity(40 * (2 + pixels.size())); // make sure buffer has enough capacity
+    coder.encodeChip(buffer, input[ic], ic % 9, 0);
+  }
+
+  ChipPixelData chip;
+  std::vector<uint16_t> seenChips;
+  std::vector<std::pair<short, short>> pixIn, pixOut; // the decoder provides the pixels sorted in col/row
+  int ic = 0;
+  while (AlpideCoder::decodeChip(chip, buffer, seenChips, [](uint16_t chipIDLoc) { return chipIDLoc; }) > 0) {
+    seenChips.clear();
+    BOOST_REQUIRE(ic < NChips);
+    BOOST_CHECK(!chip.isErrorSet());
+    BOOST_CHECK_EQUAL(chip.getChipID(), input[ic].getChipID());
+    pixIn.clear();
+    pixOut.clear();
+    for (const auto& pix : input[ic].getData()) {
+      pixIn.emplace_back(pix.getCol(), pix.getRow());
+    }
+    for (const auto& pix : chip.getData()) {
+      pixOut.emplace_back(pix.getCol(), pix.getRow());
+    }
+    std::sort(pixIn.begin(), pixIn.end());
+    BOOST_CHECK(pixIn == pixOut);
+    ic++;
+  }
+  BOOST_CHECK_EQUAL(ic, NChips);
+}
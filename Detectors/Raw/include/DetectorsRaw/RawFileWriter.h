@@ -24,6 +24,9 @@
 #include <string_view>
 #include <functional>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 #include <Rtypes.h>
 #include <TTree.h>
@@ -53,9 +56,20 @@ class RawFileWriter
 
   ///=====================================================================================
   /// output file handler with its own lock
+  /// In the async. mode the completed superpages are queued (up to maxQueued) and written by a dedicated thread
   struct OutputFile {
     FILE* handler = nullptr;
     std::mutex fileMtx;
+    //>> async writing ------
+    size_t maxQueued = 0;                     // max number of superpages waiting to be written, set once when the writer starts
+    bool writerActive = false;                // the writer thread accepts superpages, false = sync. writing
+    bool stopRequested = false;               // signal to writer thread to finish after draining the queue
+    std::deque<std::vector<char>> pages;      // superpages waiting to be written
+    std::vector<std::vector<char>> freePages; // written superpages kept for reuse of their memory
+    std::condition_variable cvPageAdded;      // signals that the new superpage was queued
+    std::condition_variable cvPageWritten;    // signals that the queue has free slot
+    std::thread writerThread;                 // writer thread
+    //<< async writing ------
     OutputFile() = default;
     OutputFile(const OutputFile& src) : handler(src.handler) {}
     OutputFile& operator=(const OutputFile& src)
@@ -65,7 +79,18 @@ class RawFileWriter
       }
       return *this;
     }
+    ~OutputFile() { stopAsync(); }
     void write(const char* data, size_t size);
+    void startAsync(size_t nQueued);
+    void stopAsync();
+    bool isAsync()
+    {
+      std::lock_guard<std::mutex> lock(fileMtx);
+      return writerActive;
+    }
+
+   private:
+    void writeLoop();
   };
   ///=====================================================================================
   struct PayloadCache {
@@ -255,6 +280,11 @@ class RawFileWriter
   int getSuperPageSize() const { return mSuperPageSize; }
   void setSuperPageSize(int nbytes);
 
+  /// write completed superpages from background thread (one per output file) with up to nQueued superpages
+  /// waiting to be written per file, 0 means synchronous writing
+  void setAsyncWriting(int nQueued);
+  int getAsyncWriting() const { return mAsyncWriteQueue; }
+
   /// get highest IR seen so far
   IR getIRMax() const;
 
@@ -414,6 +444,7 @@ class RawFileWriter
   unsigned char mAlignmentSize = 0;                                       // apply alignment to the CRU page size
   unsigned char mAlignmentPaddingFiller = 0xff;                           // using this filler
   int mSuperPageSize = 1024 * 1024;                                       // super page size
+  int mAsyncWriteQueue = 0;                                               // max superpages queued per file for async. writing (0 = sync.)
   bool mStartTFOnNewSPage = true;                                         // every TF must start on a new SPage
   bool mDontFillEmptyHBF = false;                                         // skipp adding empty HBFs (uness it must have TF flag)
   bool mAddSeparateHBFStopPage = true;                                    // HBF stop is added on a separate CRU page
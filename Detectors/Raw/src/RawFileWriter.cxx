@@ -65,6 +65,7 @@ void RawFileWriter::close()
   // close all files
   for (auto& flh : mFName2File) {
     LOG(info) << "Closing output file " << flh.first;
+    flh.second.stopAsync(); // make sure all queued superpages are written
     fclose(flh.second.handler);
     flh.second.handler = nullptr;
   }
@@ -145,6 +146,9 @@ RawFileWriter::LinkData& RawFileWriter::registerLink(uint16_t fee, uint16_t cru,
       LOG(error) << "Failed to open output file " << outFileName;
       throw std::runtime_error(std::string("cannot open link output file ") + outFileName);
     }
+    if (mAsyncWriteQueue > 0) {
+      file.startAsync(mAsyncWriteQueue);
+    }
   }
   if (!linkData.fileName.empty()) { // this link was already declared and associated with a file
     if (linkData.fileName == outFileName) {
@@ -218,6 +222,20 @@ void RawFileWriter::setSuperPageSize(int nbytes)
   assert((mSuperPageSize % RDHUtils::MAXCRUPage) == 0); // make sure it is multiple of 8KB
 }
 
+//_____________________________________________________________________
+void RawFileWriter::setAsyncWriting(int nQueued)
+{
+  // enable (nQueued>0) or disable writing of superpages by the background thread of every output file
+  mAsyncWriteQueue = nQueued > 0 ? nQueued : 0;
+  for (auto& flh : mFName2File) { // apply also to already opened files
+    if (mAsyncWriteQueue) {
+      flh.second.startAsync(mAsyncWriteQueue);
+    } else {
+      flh.second.stopAsync();
+    }
+  }
+}
+
 //_____________________________________________________________________
 IR RawFileWriter::getIRMax() const
 {
@@ -712,8 +730,78 @@ size_t RawFileWriter::LinkData::pushBack(const char* ptr, size_t sz, bool keepLa
 //____________________________________________
 void RawFileWriter::OutputFile::write(const char* data, size_t sz)
 {
+  std::unique_lock<std::mutex> lock(fileMtx);
+  // in async. mode wait for a free slot in the queue, unless the writer is being stopped: then it drains everything queued
+  cvPageWritten.wait(lock, [this] { return !writerActive || stopRequested || pages.size() < maxQueued; });
+  if (!writerActive) { // sync. mode, or the writer has already flushed all queued pages
+    fwrite(data, 1, sz, handler); // flush to file
+    return;
+  }
+  // async. mode: copy the superpage to the queue (reusing memory of already written pages), the writer thread will flush it
+  std::vector<char> page;
+  if (!freePages.empty()) {
+    page.swap(freePages.back());
+    freePages.pop_back();
+  }
+  page.assign(data, data + sz);
+  pages.emplace_back(std::move(page));
+  lock.unlock();
+  cvPageAdded.notify_one();
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::startAsync(size_t nQueued)
+{
+  if (writerThread.joinable()) { // already running, the queue size is not changed
+    return;
+  }
   std::lock_guard<std::mutex> lock(fileMtx);
-  fwrite(data, 1, sz, handler); // flush to file
+  maxQueued = nQueued;
+  stopRequested = false;
+  writerActive = true;
+  writerThread = std::thread(&RawFileWriter::OutputFile::writeLoop, this);
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::stopAsync()
+{
+  // drain the queue and stop the writer thread, further writing will be synchronous
+  if (!writerThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fileMtx);
+    stopRequested = true;
+  }
+  cvPageAdded.notify_one();
+  cvPageWritten.notify_all();
+  writerThread.join();
+  std::lock_guard<std::mutex> lock(fileMtx);
+  freePages.clear();
+}
+
+//____________________________________________
+void RawFileWriter::OutputFile::writeLoop()
+{
+  // write queued superpages in the order they were added, until the stop is requested and the queue is empty
+  std::unique_lock<std::mutex> lock(fileMtx);
+  while (true) {
+    cvPageAdded.wait(lock, [this] { return stopRequested || !pages.empty(); });
+    if (pages.empty()) {
+      writerActive = false; // everything queued is written, the producers may now write synchronously
+      break;
+    }
+    auto page = std::move(pages.front());
+    pages.pop_front();
+    lock.unlock();
+    fwrite(page.data(), 1, page.size(), handler);
+    page.clear(); // keep the capacity for reuse
+    lock.lock();
+    freePages.emplace_back(std::move(page));
+    cvPageWritten.notify_all();
+  }
+  lock.unlock();
+  cvPageWritten.notify_all();
 }
 
 //____________________________________________
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief throughput of the RawFileWriter with synchronous and asynchronous superpage writing
+// Links are filled by several producer threads, emulating TPC (few links with large HBF payload) and
+// ITS (many links with small HBF payload) raw data creation
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <string>
+#include <unistd.h>
+#include <fmt/format.h>
+#include "DetectorsRaw/RawFileWriter.h"
+#include "DetectorsRaw/HBFUtils.h"
+
+using namespace o2::raw;
+using IR = o2::InteractionRecord;
+
+constexpr int NOrbits = 256; // number of HBFs to write per link
+
+// state.range: 0 - number of links, 1 - payload per link per HBF in bytes, 2 - async. queue size (0 = sync.), 3 - number of producer threads
+static void BM_RawFileWriter(benchmark::State& state)
+{
+  const int nLinks = state.range(0);
+  const int payloadSize = state.range(1);
+  const int asyncQueue = state.range(2);
+  const int nThreads = state.range(3);
+  const auto outDir = std::filesystem::temp_directory_path() / fmt::format("benchRawWriter{}", ::getpid());
+  std::filesystem::create_directories(outDir);
+  std::vector<char> payload(payloadSize, 0x5a);
+  size_t nBytes = 0;
+
+  for (auto _ : state) {
+    RawFileWriter writer{"TST"};
+    writer.setContinuousReadout();
+    writer.setAsyncWriting(asyncQueue);
+    writer.doLazinessCheck(false); // LazinessCheck is not thread-safe
+    for (int il = 0; il < nLinks; il++) { // every producer thread writes its own file
+      writer.registerLink(il, il / 24, il % 24, 0, (outDir / fmt::format("raw_thr{}.raw", il % nThreads)).string());
+    }
+    const auto ir0 = HBFUtils::Instance().getFirstSampledTFIR();
+    auto producer = [&writer, &payload, ir0, nLinks, nThreads](int thread) {
+      for (int orb = 0; orb < NOrbits; orb++) {
+        IR ir{0, ir0.orbit + orb};
+        for (int il = thread; il < nLinks; il += nThreads) {
+          writer.addData(il, il / 24, il % 24, 0, ir, payload);
+        }
+      }
+    };
+    std::vector<std::thread> producers;
+    for (int ith = 0; ith < nThreads; ith++) {
+      producers.emplace_back(producer, ith);
+    }
+    for (auto& th : producers) {
+      th.join();
+    }
+    writer.close();
+    nBytes += size_t(nLinks) * NOrbits * payloadSize;
+  }
+  std::filesystem::remove_all(outDir);
+  state.SetBytesProcessed(nBytes);
+}
+
+// TPC-like: 72 links with ~32KB per HBF
+BENCHMARK(BM_RawFileWriter)->Args({72, 32768, 0, 1})->Args({72, 32768, 8, 1})->Args({72, 32768, 0, 4})->Args({72, 32768, 8, 4})->Unit(benchmark::kMillisecond);
+// ITS-like: 576 links with ~1KB per HBF
+BENCHMARK(BM_RawFileWriter)->Args({576, 1024, 0, 1})->Args({576, 1024, 8, 1})->Args({576, 1024, 0, 4})->Args({576, 1024, 8, 4})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,101 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test RawFileWriter async writing
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "DetectorsRaw/RawFileWriter.h"
+
+// @brief several producers writing superpages concurrently to the same output file in async. mode
+
+namespace o2
+{
+using namespace o2::raw;
+
+constexpr int NProducers = 4;
+constexpr int NPagesPerProducer = 200;
+constexpr size_t PageSize = 1024;
+
+// every page is filled with the producer ID and carries its sequence number in the first bytes
+void writePages(RawFileWriter::OutputFile& file, int producer)
+{
+  std::vector<char> page(PageSize, char(producer));
+  for (int i = 0; i < NPagesPerProducer; i++) {
+    *reinterpret_cast<int*>(page.data()) = i;
+    file.write(page.data(), page.size());
+  }
+}
+
+// check that all pages are in the file, in order for every producer
+void checkFile(FILE* handler)
+{
+  std::rewind(handler);
+  std::vector<int> nextPage(NProducers, 0);
+  std::vector<char> page(PageSize);
+  int nPages = 0;
+  while (std::fread(page.data(), 1, PageSize, handler) == PageSize) {
+    int producer = page.back();
+    BOOST_REQUIRE(producer >= 0 && producer < NProducers);
+    BOOST_CHECK_EQUAL(*reinterpret_cast<int*>(page.data()), nextPage[producer]);
+    nextPage[producer]++;
+    nPages++;
+  }
+  BOOST_CHECK_EQUAL(nPages, NProducers * NPagesPerProducer);
+  for (int producer = 0; producer < NProducers; producer++) {
+    BOOST_CHECK_EQUAL(nextPage[producer], NPagesPerProducer);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RawFileWriterAsyncProducers)
+{
+  RawFileWriter::OutputFile file;
+  file.handler = std::tmpfile();
+  BOOST_REQUIRE(file.handler);
+  file.startAsync(2);
+  BOOST_CHECK(file.isAsync());
+  std::vector<std::thread> producers;
+  for (int i = 0; i < NProducers; i++) {
+    producers.emplace_back(writePages, std::ref(file), i);
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  file.stopAsync();
+  BOOST_CHECK(!file.isAsync());
+  checkFile(file.handler);
+  std::fclose(file.handler);
+}
+
+BOOST_AUTO_TEST_CASE(RawFileWriterAsyncStopWhileWriting)
+{
+  // stopping the writer while the producers are blocked on the full queue must neither lose pages nor deadlock
+  RawFileWriter::OutputFile file;
+  file.handler = std::tmpfile();
+  BOOST_REQUIRE(file.handler);
+  file.startAsync(1);
+  std::vector<std::thread> producers;
+  for (int i = 0; i < NProducers; i++) {
+    producers.emplace_back(writePages, std::ref(file), i);
+  }
+  file.stopAsync();
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  BOOST_CHECK(!file.isAsync());
+  checkFile(file.handler);
+  std::fclose(file.handler);
+}
+
+} // namespace o2
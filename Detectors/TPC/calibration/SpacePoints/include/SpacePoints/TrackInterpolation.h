@@ -186,6 +186,29 @@ class TrackInterpolation
     std::bitset<param::NPadRows> flagRej{};
   };
 
+  /// Buffers owned by each processing thread. They are kept across the TFs to avoid reallocations
+  struct ThreadBuffers {
+    std::array<CacheStruct, constants::MAXGLOBALPADROW> cache{{}}; ///< caching positions, covariances and angles for track extrapolations and interpolation
+    std::vector<TPCClusterResiduals> clusterResiduals{};            ///< residuals of the track being processed
+    std::vector<UnbinnedResid> clRes{};                             ///< validated residuals of the tracks processed by this thread
+    std::vector<TPCClusterResiduals> clResUnfiltered{};             ///< residuals before outlier filtering of the tracks processed by this thread
+    std::vector<TrackDataExtended> trackDataExtended{};             ///< debug information of the tracks processed by this thread
+    void clear();
+  };
+
+  /// Result of the extra-/interpolation of a single seed, referring to the buffers of the thread which processed it
+  struct SeedResult {
+    o2::track::TrackParCov trkWork{}; ///< seed parameters after the propagation
+    TrackData trackData{};            ///< track quality information
+    int thread{-1};                   ///< index of the buffers holding the residuals, -1 if the track could not be processed
+    bool processed{false};            ///< whether or not the seed was already processed
+    bool accepted{false};             ///< whether or not the track passed the validation
+    uint32_t firstClRes{0};           ///< index of the first validated residual in ThreadBuffers::clRes
+    uint32_t firstClResUnfiltered{0}; ///< index of the first residual in ThreadBuffers::clResUnfiltered
+    uint32_t nClResUnfiltered{0};     ///< number of residuals before outlier filtering
+    int extendedIdx{-1};              ///< index in ThreadBuffers::trackDataExtended
+  };
+
   // -------------------------------------- processing functions --------------------------------------------------
 
   /// Initialize everything, set the requested track sources
@@ -214,6 +237,21 @@ class TrackInterpolation
   /// \param seed index
   void interpolateTrack(int iSeed);
 
+  /// Extrapolate ITS-only track through TPC, keeping the residuals in the buffers of thread iThread
+  void extrapolateTrack(int iSeed, int iThread, SeedResult& result);
+
+  /// Interpolate ITS-TRD-TOF track inside TPC, keeping the residuals in the buffers of thread iThread
+  void interpolateTrack(int iSeed, int iThread, SeedResult& result);
+
+  /// Inter- or extrapolate the given seed depending on its source
+  void processSeed(int iSeed, int iThread, SeedResult& result);
+
+  /// Process in parallel nSeeds seeds with the given indices
+  void processSeeds(const int* seedIndices, int nSeeds, std::vector<SeedResult>& results);
+
+  /// Move the result for the given seed from the thread buffers to the output vectors (processing the seed if not yet done)
+  void storeSeedResult(int iSeed, SeedResult& result);
+
   /// Reset cache and output vectors
   void reset();
 
@@ -270,6 +308,10 @@ class TrackInterpolation
   /// Set the centre of mass energy required for pT downsampling Tsalis function
   void setSqrtS(float s) { mSqrtS = s; }
 
+  /// Set the number of threads used to process the seeds
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   // --------------------------------- output ---------------------------------------------
   std::vector<UnbinnedResid>& getClusterResiduals() { return mClRes; }
   std::vector<TrackDataCompact>& getTrackDataCompact() { return mTrackDataCompact; }
@@ -280,6 +322,7 @@ class TrackInterpolation
 
  private:
   static constexpr float sFloatEps{1.e-7f}; ///< float epsilon for robust linear fitting
+  static constexpr int sMinSeedsPerThread{16}; ///< minimum number of seeds per thread to process in one go when the number of tracks is limited
   // parameters + settings
   const SpacePointsCalibConfParam* mParams = nullptr;
   float mTPCTimeBinMUS{.2f};    ///< TPC time bin duration in us
@@ -292,6 +335,7 @@ class TrackInterpolation
   bool mDumpTrackPoints{false};                      ///< dump also track points in ITS, TRD and TOF
   bool mProcessSeeds{false};                         ///< in case for global tracks also their shorter parts are processed separately
   bool mProcessITSTPConly{false};                    ///< flag, whether or not to extrapolate ITS-only through TPC
+  int mNThreads{1};                                  ///< number of threads used to process the seeds
   o2::dataformats::GlobalTrackID::mask_t mSourcesConfigured;    ///< the track sources taken into account for extra-/interpolation
   o2::dataformats::GlobalTrackID::mask_t mSourcesConfiguredMap; ///< possible subset of mSourcesConfigured
   bool mSingleSourcesConfigured{true};                          ///< whether mSourcesConfigured == mSourcesConfiguredMap
@@ -320,8 +364,8 @@ class TrackInterpolation
   std::vector<TPCClusterResiduals> mClResUnfiltered{}; ///< same as mClRes, but for all residuals before outlier filtering
 
   // cache
-  std::array<CacheStruct, constants::MAXGLOBALPADROW> mCache{{}}; ///< caching positions, covariances and angles for track extrapolations and interpolation
-  std::vector<o2::dataformats::GlobalTrackID> mGIDsSuccess;       ///< keep track of the GIDs which could be processed successfully
+  std::vector<ThreadBuffers> mThreadBuffers;                //! per thread caches and residuals
+  std::vector<o2::dataformats::GlobalTrackID> mGIDsSuccess; ///< keep track of the GIDs which could be processed successfully
 
   // helpers
   o2::trd::RecoParam mRecoParam;                      ///< parameters required for TRD refit
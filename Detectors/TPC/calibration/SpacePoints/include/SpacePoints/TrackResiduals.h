@@ -149,6 +149,10 @@ class TrackResiduals
 
   void setT0Corr(float corr) { mEffT0Corr = corr; }
 
+  /// Sets the number of threads used to process the voxels of a sector (requires OpenMP).
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
+
   // -------------------------------------- I/O --------------------------------------------------
 
   std::vector<LocalResid>& getLocalResVec() { return mLocalResidualsIn; }
@@ -242,7 +246,7 @@ class TrackResiduals
   /// \param res Array to store the results
   /// \param whichDim Integer value with bits set for the dimensions which need to be smoothed
   /// \return Flag if the estimate was successfull
-  bool getSmoothEstimate(int iSec, float x, float p, float z, std::array<float, ResDim>& res, int whichDim = 0);
+  bool getSmoothEstimate(int iSec, float x, float p, float z, std::array<float, ResDim>& res, int whichDim = 0) const;
 
   /// Calculates the weight of the given point used for the kernel smoothing.
   /// Takes into account the defined kernel in mKernelType.
@@ -455,6 +459,7 @@ class TrackResiduals
 
   // settings
   const SpacePointsCalibConfParam* mParams = nullptr;
+  int mNThreads{1}; ///<! number of threads used to process the voxels of a sector
 
   // input data
   std::vector<LocalResid> mLocalResidualsIn;                        ///< binned local residuals from aggregator
@@ -493,7 +498,6 @@ class TrackResiduals
   std::array<int, VoxDim> mStepKern{};                             ///< N bins to consider with given kernel settings
   std::array<float, VoxDim> mKernelScaleEdge{};                    ///< optional scaling factors for kernel width on the edge
   std::array<float, VoxDim> mKernelWInv{};                         ///< inverse kernel width in bins
-  std::array<double, ResDim * sMaxSmtDim> mLastSmoothingRes{};     ///< results of last smoothing operation
   // calibrated parameters
   float mEffVdriftCorr{0.f}; ///< global correction factor for vDrift based on d(delta(z))/dz fit
   float mEffT0Corr{0.f};     ///< global correction for T0 shift from offset of d(delta(z))/dz fit
@@ -504,7 +508,7 @@ class TrackResiduals
   VoxRes mVoxelResultsOut{};                                                                ///< the results from mVoxelResults are copied in here to be able to stream them
   VoxRes* mVoxelResultsOutPtr{&mVoxelResultsOut};                                           ///< pointer to set the branch address to for the output
 
-  ClassDefNV(TrackResiduals, 3);
+  ClassDefNV(TrackResiduals, 4);
 };
 
 //_____________________________________________________
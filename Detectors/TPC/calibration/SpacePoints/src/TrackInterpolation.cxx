@@ -32,12 +32,28 @@
 #include "Framework/Logger.h"
 #include <set>
 #include <algorithm>
+#include <numeric>
 #include <random>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 using namespace o2::tpc;
 using GTrackID = o2::dataformats::GlobalTrackID;
 using DetID = o2::detectors::DetID;
 
+namespace
+{
+inline int getThreadID()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
 void TrackInterpolation::init(o2::dataformats::GlobalTrackID::mask_t src, o2::dataformats::GlobalTrackID::mask_t srcMap)
 {
   // perform initialization
@@ -60,6 +76,7 @@ void TrackInterpolation::init(o2::dataformats::GlobalTrackID::mask_t src, o2::da
   mSourcesConfigured = src;
   mSourcesConfiguredMap = srcMap;
   mSingleSourcesConfigured = (mSourcesConfigured == mSourcesConfiguredMap);
+  mThreadBuffers.resize(mNThreads);
   mTrackTypes.insert({GTrackID::ITSTPC, 0});
   mTrackTypes.insert({GTrackID::ITSTPCTRD, 1});
   mTrackTypes.insert({GTrackID::ITSTPCTOF, 2});
@@ -276,33 +293,60 @@ void TrackInterpolation::process()
   int maxOutputTracks = (mMaxTracksPerTF >= 0) ? mMaxTracksPerTF + mAddTracksForMapPerTF : nSeeds;
   mTrackData.reserve(maxOutputTracks);
   mClRes.reserve(maxOutputTracks * param::NPadRows);
-  bool maxTracksReached = false;
+  // The downsampling is decided upfront, so that the selected seeds can be processed in parallel.
+  // The seeds are processed in chunks and the results are stored in the order of the seeds,
+  // so that the output does not depend on the number of threads
+  std::vector<int> seedIndices;
+  seedIndices.reserve(nSeeds);
   for (int iSeed = 0; iSeed < nSeeds; ++iSeed) {
-    if (mMaxTracksPerTF >= 0 && mTrackDataCompact.size() >= mMaxTracksPerTF + mAddTracksForMapPerTF) {
-      LOG(info) << "Maximum number of tracks per TF reached. Skipping the remaining " << nSeeds - iSeed << " tracks.";
-      break;
-    }
     int seedIndex = trackIndices[iSeed];
     if (mParams->enableTrackDownsampling && !isTrackSelected(mSeeds[seedIndex])) {
       continue;
     }
-    if (!mSingleSourcesConfigured && !mSourcesConfiguredMap[mGIDs[seedIndex].getSource()]) {
-      auto src = findValidSource(mSourcesConfiguredMap, static_cast<GTrackID::Source>(mGIDs[seedIndex].getSource()));
-      if (src == GTrackID::ITSTPCTRD || src == GTrackID::ITSTPC) {
-        LOGP(debug, "process: Found valid source {}", GTrackID::getSourceName(src));
-        mGIDs.push_back(mGIDtables[seedIndex][src]);
-        mGIDtables.push_back(mRecoCont->getSingleDetectorRefs(mGIDs.back()));
-        mTrackTimes.push_back(mTrackTimes[seedIndex]);
-        mSeeds.push_back(mSeeds[seedIndex]);
-      }
+    seedIndices.push_back(seedIndex);
+  }
+  // in case the number of tracks is limited, process in one go only about as many seeds as tracks are still missing
+  auto getChunkSize = [this](int nAvailable, int nMax) {
+    if (mMaxTracksPerTF < 0) {
+      return nAvailable;
     }
-    if (mMaxTracksPerTF >= 0 && mTrackDataCompact.size() >= mMaxTracksPerTF) {
-      LOG(debug) << "We already have reached mMaxTracksPerTF, but we continue to create seeds until mAddTracksForMapPerTF is also reached";
-      continue;
+    int nMissing = nMax - (int)mTrackDataCompact.size();
+    return std::min(nAvailable, std::max(nMissing, mNThreads * sMinSeedsPerThread));
+  };
+  std::vector<SeedResult> results;
+  int nSelected = seedIndices.size();
+  bool maxTracksReached = false;
+  for (int iFirst = 0; iFirst < nSelected && !maxTracksReached;) {
+    int nChunk = getChunkSize(nSelected - iFirst, mMaxTracksPerTF);
+    if (mMaxTracksPerTF < 0 || mTrackDataCompact.size() < mMaxTracksPerTF) {
+      processSeeds(&seedIndices[iFirst], nChunk, results);
+    } else {
+      // only additional seeds for the map will be created, no need to process anything
+      results.assign(nChunk, SeedResult{});
     }
-    if (mGIDs[seedIndex].includesDet(DetID::TRD) || mGIDs[seedIndex].includesDet(DetID::TOF)) {
-      interpolateTrack(seedIndex);
-      if (mProcessSeeds) {
+    for (int iChunk = 0; iChunk < nChunk; ++iChunk) {
+      if (mMaxTracksPerTF >= 0 && mTrackDataCompact.size() >= mMaxTracksPerTF + mAddTracksForMapPerTF) {
+        LOG(info) << "Maximum number of tracks per TF reached. Skipping the remaining " << nSelected - iFirst - iChunk << " tracks.";
+        maxTracksReached = true;
+        break;
+      }
+      int seedIndex = seedIndices[iFirst + iChunk];
+      if (!mSingleSourcesConfigured && !mSourcesConfiguredMap[mGIDs[seedIndex].getSource()]) {
+        auto src = findValidSource(mSourcesConfiguredMap, static_cast<GTrackID::Source>(mGIDs[seedIndex].getSource()));
+        if (src == GTrackID::ITSTPCTRD || src == GTrackID::ITSTPC) {
+          LOGP(debug, "process: Found valid source {}", GTrackID::getSourceName(src));
+          mGIDs.push_back(mGIDtables[seedIndex][src]);
+          mGIDtables.push_back(mRecoCont->getSingleDetectorRefs(mGIDs.back()));
+          mTrackTimes.push_back(mTrackTimes[seedIndex]);
+          mSeeds.push_back(mSeeds[seedIndex]);
+        }
+      }
+      if (mMaxTracksPerTF >= 0 && mTrackDataCompact.size() >= mMaxTracksPerTF) {
+        LOG(debug) << "We already have reached mMaxTracksPerTF, but we continue to create seeds until mAddTracksForMapPerTF is also reached";
+        continue;
+      }
+      storeSeedResult(seedIndex, results[iChunk]);
+      if (mProcessSeeds && (mGIDs[seedIndex].includesDet(DetID::TRD) || mGIDs[seedIndex].includesDet(DetID::TOF))) {
         if (mGIDs[seedIndex].includesDet(DetID::TRD) && mGIDs[seedIndex].includesDet(DetID::TOF)) {
           mGIDs.push_back(mGIDtables[seedIndex][GTrackID::ITSTPCTRD]);
           mGIDtables.push_back(mRecoCont->getSingleDetectorRefs(mGIDs.back()));
@@ -314,35 +358,124 @@ void TrackInterpolation::process()
         mTrackTimes.push_back(mTrackTimes[seedIndex]);
         mSeeds.push_back(mSeeds[seedIndex]);
       }
-    } else {
-      extrapolateTrack(seedIndex);
     }
+    iFirst += nChunk;
   }
   if (mSeeds.size() > nSeeds) {
     LOGP(info, "Up to {} tracks out of {} additional seeds will be processed", mAddTracksForMapPerTF, mSeeds.size() - nSeeds);
   }
-  for (int iSeed = nSeeds; iSeed < (int)mSeeds.size(); ++iSeed) {
-    if (!mProcessSeeds && mAddTracksForMapPerTF > 0 && mTrackDataCompact.size() >= mMaxTracksPerTF + mAddTracksForMapPerTF) {
-      LOG(info) << "Maximum number of additional tracks per TF reached. Skipping the remaining " << mSeeds.size() - iSeed << " tracks.";
-      break;
+  // this loop will only be entered in case mProcessSeeds is set or different sources are used for the map
+  seedIndices.resize(mSeeds.size() - nSeeds);
+  std::iota(seedIndices.begin(), seedIndices.end(), nSeeds);
+  int nAdditional = seedIndices.size();
+  for (int iFirst = 0; iFirst < nAdditional;) {
+    int nChunk = mProcessSeeds ? nAdditional : getChunkSize(nAdditional - iFirst, mMaxTracksPerTF + mAddTracksForMapPerTF);
+    processSeeds(&seedIndices[iFirst], nChunk, results);
+    bool done = false;
+    for (int iChunk = 0; iChunk < nChunk; ++iChunk) {
+      int iSeed = seedIndices[iFirst + iChunk];
+      if (!mProcessSeeds && mAddTracksForMapPerTF > 0 && mTrackDataCompact.size() >= mMaxTracksPerTF + mAddTracksForMapPerTF) {
+        LOG(info) << "Maximum number of additional tracks per TF reached. Skipping the remaining " << mSeeds.size() - iSeed << " tracks.";
+        done = true;
+        break;
+      }
+      LOGP(debug, "Processing additional track {}", mGIDs[iSeed].asString());
+      storeSeedResult(iSeed, results[iChunk]);
     }
-    // this loop will only be entered in case mProcessSeeds is set
-    LOGP(debug, "Processing additional track {}", mGIDs[iSeed].asString());
-    if (mGIDs[iSeed].includesDet(DetID::TRD) || mGIDs[iSeed].includesDet(DetID::TOF)) {
-      interpolateTrack(iSeed);
-    } else {
-      extrapolateTrack(iSeed);
+    if (done) {
+      break;
     }
+    iFirst += nChunk;
   }
   LOG(info) << "Could process " << mTrackData.size() << " tracks successfully";
 }
 
+void TrackInterpolation::processSeeds(const int* seedIndices, int nSeeds, std::vector<SeedResult>& results)
+{
+  // all previous results were already stored, so the thread buffers can be reused
+  for (auto& buffers : mThreadBuffers) {
+    buffers.clear();
+  }
+  results.assign(nSeeds, SeedResult{});
+#ifdef WITH_OPENMP
+  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int i = 0; i < nSeeds; ++i) {
+    processSeed(seedIndices[i], getThreadID(), results[i]);
+  }
+}
+
+void TrackInterpolation::processSeed(int iSeed, int iThread, SeedResult& result)
+{
+  result.processed = true;
+  if (mGIDs[iSeed].includesDet(DetID::TRD) || mGIDs[iSeed].includesDet(DetID::TOF)) {
+    interpolateTrack(iSeed, iThread, result);
+  } else {
+    extrapolateTrack(iSeed, iThread, result);
+  }
+}
+
+void TrackInterpolation::storeSeedResult(int iSeed, SeedResult& result)
+{
+  if (!result.processed) {
+    processSeed(iSeed, 0, result);
+  }
+  mSeeds[iSeed] = result.trkWork;
+  if (result.thread < 0) {
+    // the track could not be processed
+    return;
+  }
+  auto& buffers = mThreadBuffers[result.thread];
+  auto& trackData = result.trackData;
+  if (result.accepted) {
+    int nClValidated = trackData.clIdx.getEntries();
+    trackData.clIdx.setFirstEntry(mClRes.size());
+    mClRes.insert(mClRes.end(), buffers.clRes.begin() + result.firstClRes, buffers.clRes.begin() + result.firstClRes + nClValidated);
+    mTrackData.push_back(trackData);
+    if (mDumpTrackPoints) {
+      auto& trackDataExtended = buffers.trackDataExtended[result.extendedIdx];
+      trackDataExtended.clIdx.setFirstEntry(trackData.clIdx.getFirstEntry());
+      mTrackDataExtended.push_back(std::move(trackDataExtended));
+    }
+    mGIDsSuccess.push_back(mGIDs[iSeed]);
+    mTrackDataCompact.emplace_back(mClRes.size() - nClValidated, nClValidated, mGIDs[iSeed].getSource());
+  }
+  if (mParams->writeUnfiltered) {
+    TrackData trkDataTmp = trackData;
+    trkDataTmp.clIdx.setFirstEntry(mClResUnfiltered.size());
+    trkDataTmp.clIdx.setEntries(result.nClResUnfiltered);
+    mTrackDataUnfiltered.push_back(std::move(trkDataTmp));
+    auto first = buffers.clResUnfiltered.begin() + result.firstClResUnfiltered;
+    mClResUnfiltered.insert(mClResUnfiltered.end(), first, first + result.nClResUnfiltered);
+  }
+}
+
 void TrackInterpolation::interpolateTrack(int iSeed)
+{
+  SeedResult result;
+  interpolateTrack(iSeed, 0, result);
+  result.processed = true;
+  storeSeedResult(iSeed, result);
+}
+
+void TrackInterpolation::extrapolateTrack(int iSeed)
+{
+  SeedResult result;
+  extrapolateTrack(iSeed, 0, result);
+  result.processed = true;
+  storeSeedResult(iSeed, result);
+}
+
+void TrackInterpolation::interpolateTrack(int iSeed, int iThread, SeedResult& result)
 {
   LOGP(debug, "Starting track interpolation for GID {}", mGIDs[iSeed].asString());
-  TrackData trackData;
+  auto& buffers = mThreadBuffers[iThread];
+  auto& cache = buffers.cache;
+  auto& trackData = result.trackData;
   std::unique_ptr<TrackDataExtended> trackDataExtended;
-  std::vector<TPCClusterResiduals> clusterResiduals;
+  auto& clusterResiduals = buffers.clusterResiduals;
+  clusterResiduals.clear();
   auto propagator = o2::base::Propagator::Instance();
   const auto& gidTable = mGIDtables[iSeed];
   const auto& trkTPC = mRecoCont->getTPCTrack(gidTable[GTrackID::TPC]);
@@ -350,7 +483,6 @@ void TrackInterpolation::interpolateTrack(int iSeed)
   if (mDumpTrackPoints) {
     trackDataExtended = std::make_unique<TrackDataExtended>();
     (*trackDataExtended).gid = mGIDs[iSeed];
-    (*trackDataExtended).clIdx.setFirstEntry(mClRes.size());
     (*trackDataExtended).trkITS = trkITS;
     (*trackDataExtended).trkTPC = trkTPC;
     auto nCl = trkITS.getNumberOfClusters();
@@ -362,12 +494,12 @@ void TrackInterpolation::interpolateTrack(int iSeed)
   }
   trackData.gid = mGIDs[iSeed];
   trackData.par = mSeeds[iSeed];
-  auto& trkWork = mSeeds[iSeed];
+  result.trkWork = mSeeds[iSeed];
+  auto& trkWork = result.trkWork;
   // reset the cache array (sufficient to set cluster available to zero)
-  for (auto& elem : mCache) {
+  for (auto& elem : cache) {
     elem.clAvailable = 0;
   }
-  trackData.clIdx.setFirstEntry(mClRes.size()); // reference the first cluster residual belonging to this track
   float clusterTimeBinOffset = mTrackTimes[iSeed] / mTPCTimeBinMUS;
 
   // store the TPC cluster positions in the cache
@@ -378,19 +510,19 @@ void TrackInterpolation::interpolateTrack(int iSeed)
     float clTPCX;
     std::array<float, 2> clTPCYZ;
     mFastTransform->TransformIdeal(sector, row, clTPC.getPad(), clTPC.getTime(), clTPCX, clTPCYZ[0], clTPCYZ[1], clusterTimeBinOffset);
-    mCache[row].clSec = sector;
-    mCache[row].clAvailable = 1;
-    mCache[row].clY = clTPCYZ[0];
-    mCache[row].clZ = clTPCYZ[1];
-    mCache[row].clAngle = o2::math_utils::sector2Angle(sector);
+    cache[row].clSec = sector;
+    cache[row].clAvailable = 1;
+    cache[row].clY = clTPCYZ[0];
+    cache[row].clZ = clTPCYZ[1];
+    cache[row].clAngle = o2::math_utils::sector2Angle(sector);
   }
 
   // extrapolate seed through TPC and store track position at each pad row
   for (int iRow = 0; iRow < param::NPadRows; ++iRow) {
-    if (!mCache[iRow].clAvailable) {
+    if (!cache[iRow].clAvailable) {
       continue;
     }
-    if (!trkWork.rotate(mCache[iRow].clAngle)) {
+    if (!trkWork.rotate(cache[iRow].clAngle)) {
       LOG(debug) << "Failed to rotate track during first extrapolation";
       return;
     }
@@ -398,12 +530,12 @@ void TrackInterpolation::interpolateTrack(int iSeed)
       LOG(debug) << "Failed on first extrapolation";
       return;
     }
-    mCache[iRow].y[ExtOut] = trkWork.getY();
-    mCache[iRow].z[ExtOut] = trkWork.getZ();
-    mCache[iRow].sy2[ExtOut] = trkWork.getSigmaY2();
-    mCache[iRow].szy[ExtOut] = trkWork.getSigmaZY();
-    mCache[iRow].sz2[ExtOut] = trkWork.getSigmaZ2();
-    mCache[iRow].snp[ExtOut] = trkWork.getSnp();
+    cache[iRow].y[ExtOut] = trkWork.getY();
+    cache[iRow].z[ExtOut] = trkWork.getZ();
+    cache[iRow].sy2[ExtOut] = trkWork.getSigmaY2();
+    cache[iRow].szy[ExtOut] = trkWork.getSigmaZY();
+    cache[iRow].sz2[ExtOut] = trkWork.getSigmaZ2();
+    cache[iRow].snp[ExtOut] = trkWork.getSnp();
     //printf("Track alpha at row %i: %.2f, Y(%.2f), Z(%.2f)\n", iRow, trkWork.getAlpha(), trkWork.getY(), trkWork.getZ());
   }
 
@@ -491,7 +623,7 @@ void TrackInterpolation::interpolateTrack(int iSeed)
   // go back through the TPC and store updated track positions
   bool outerParamStored = false;
   for (int iRow = param::NPadRows; iRow--;) {
-    if (!mCache[iRow].clAvailable) {
+    if (!cache[iRow].clAvailable) {
       continue;
     }
     if (mProcessSeeds && !outerParamStored) {
@@ -503,7 +635,7 @@ void TrackInterpolation::interpolateTrack(int iSeed)
       trackData.par = trkWork;
       outerParamStored = true;
     }
-    if (!trkWork.rotate(mCache[iRow].clAngle)) {
+    if (!trkWork.rotate(cache[iRow].clAngle)) {
       LOG(debug) << "Failed to rotate track during back propagation";
       return;
     }
@@ -512,36 +644,36 @@ void TrackInterpolation::interpolateTrack(int iSeed)
       //printf("trkX(%.2f), clX(%.2f), clY(%.2f), clZ(%.2f), alphaTOF(%.2f)\n", trkWork.getX(), param::RowX[iRow], clTOFYZ[0], clTOFYZ[1], clTOFAlpha);
       return;
     }
-    mCache[iRow].y[ExtIn] = trkWork.getY();
-    mCache[iRow].z[ExtIn] = trkWork.getZ();
-    mCache[iRow].sy2[ExtIn] = trkWork.getSigmaY2();
-    mCache[iRow].szy[ExtIn] = trkWork.getSigmaZY();
-    mCache[iRow].sz2[ExtIn] = trkWork.getSigmaZ2();
-    mCache[iRow].snp[ExtIn] = trkWork.getSnp();
+    cache[iRow].y[ExtIn] = trkWork.getY();
+    cache[iRow].z[ExtIn] = trkWork.getZ();
+    cache[iRow].sy2[ExtIn] = trkWork.getSigmaY2();
+    cache[iRow].szy[ExtIn] = trkWork.getSigmaZY();
+    cache[iRow].sz2[ExtIn] = trkWork.getSigmaZ2();
+    cache[iRow].snp[ExtIn] = trkWork.getSnp();
   }
 
   // calculate weighted mean at each pad row (assume for now y and z are uncorrelated) and store residuals to TPC clusters
   unsigned short deltaRow = 0;
   for (int iRow = 0; iRow < param::NPadRows; ++iRow) {
-    if (!mCache[iRow].clAvailable) {
+    if (!cache[iRow].clAvailable) {
       ++deltaRow;
       continue;
     }
-    float wTotY = 1.f / mCache[iRow].sy2[ExtOut] + 1.f / mCache[iRow].sy2[ExtIn];
-    float wTotZ = 1.f / mCache[iRow].sz2[ExtOut] + 1.f / mCache[iRow].sz2[ExtIn];
-    mCache[iRow].y[Int] = (mCache[iRow].y[ExtOut] / mCache[iRow].sy2[ExtOut] + mCache[iRow].y[ExtIn] / mCache[iRow].sy2[ExtIn]) / wTotY;
-    mCache[iRow].z[Int] = (mCache[iRow].z[ExtOut] / mCache[iRow].sz2[ExtOut] + mCache[iRow].z[ExtIn] / mCache[iRow].sz2[ExtIn]) / wTotZ;
+    float wTotY = 1.f / cache[iRow].sy2[ExtOut] + 1.f / cache[iRow].sy2[ExtIn];
+    float wTotZ = 1.f / cache[iRow].sz2[ExtOut] + 1.f / cache[iRow].sz2[ExtIn];
+    cache[iRow].y[Int] = (cache[iRow].y[ExtOut] / cache[iRow].sy2[ExtOut] + cache[iRow].y[ExtIn] / cache[iRow].sy2[ExtIn]) / wTotY;
+    cache[iRow].z[Int] = (cache[iRow].z[ExtOut] / cache[iRow].sz2[ExtOut] + cache[iRow].z[ExtIn] / cache[iRow].sz2[ExtIn]) / wTotZ;
 
     // simple average w/o weighting for angle
-    mCache[iRow].snp[Int] = (mCache[iRow].snp[ExtOut] + mCache[iRow].snp[ExtIn]) / 2.f;
+    cache[iRow].snp[Int] = (cache[iRow].snp[ExtOut] + cache[iRow].snp[ExtIn]) / 2.f;
 
     TPCClusterResiduals res;
-    res.setDY(mCache[iRow].clY - mCache[iRow].y[Int]);
-    res.setDZ(mCache[iRow].clZ - mCache[iRow].z[Int]);
-    res.setY(mCache[iRow].y[Int]);
-    res.setZ(mCache[iRow].z[Int]);
-    res.setSnp(mCache[iRow].snp[Int]);
-    res.sec = mCache[iRow].clSec;
+    res.setDY(cache[iRow].clY - cache[iRow].y[Int]);
+    res.setDZ(cache[iRow].clZ - cache[iRow].z[Int]);
+    res.setY(cache[iRow].y[Int]);
+    res.setZ(cache[iRow].z[Int]);
+    res.setSnp(cache[iRow].snp[Int]);
+    res.sec = cache[iRow].clSec;
     res.dRow = deltaRow;
     clusterResiduals.push_back(std::move(res));
     deltaRow = 1;
@@ -556,10 +688,12 @@ void TrackInterpolation::interpolateTrack(int iSeed)
   trackData.dEdxTPC = trkTPC.getdEdx().dEdxTotTPC;
 
   TrackParams params; // for refitted track parameters and flagging rejected clusters
+  result.thread = iThread;
   if (mParams->skipOutlierFiltering || validateTrack(trackData, params, clusterResiduals)) {
     // track is good
     int nClValidated = 0;
     int iRow = 0;
+    result.firstClRes = buffers.clRes.size();
     for (unsigned int iCl = 0; iCl < clusterResiduals.size(); ++iCl) {
       iRow += clusterResiduals[iCl].dRow;
       if (params.flagRej[iCl]) {
@@ -568,41 +702,38 @@ void TrackInterpolation::interpolateTrack(int iSeed)
       }
       ++nClValidated;
       float tgPhi = clusterResiduals[iCl].snp / std::sqrt((1.f - clusterResiduals[iCl].snp) * (1.f + clusterResiduals[iCl].snp));
-      mClRes.emplace_back(clusterResiduals[iCl].dy, clusterResiduals[iCl].dz, tgPhi, clusterResiduals[iCl].y, clusterResiduals[iCl].z, iRow, clusterResiduals[iCl].sec);
+      buffers.clRes.emplace_back(clusterResiduals[iCl].dy, clusterResiduals[iCl].dz, tgPhi, clusterResiduals[iCl].y, clusterResiduals[iCl].z, iRow, clusterResiduals[iCl].sec);
     }
     trackData.clIdx.setEntries(nClValidated);
-    mTrackData.push_back(std::move(trackData));
+    result.accepted = true;
     if (mDumpTrackPoints) {
       (*trackDataExtended).clIdx.setEntries(nClValidated);
-      mTrackDataExtended.push_back(std::move(*trackDataExtended));
+      result.extendedIdx = buffers.trackDataExtended.size();
+      buffers.trackDataExtended.push_back(std::move(*trackDataExtended));
     }
-    mGIDsSuccess.push_back(mGIDs[iSeed]);
-    mTrackDataCompact.emplace_back(mClRes.size() - nClValidated, nClValidated, mGIDs[iSeed].getSource());
   }
   if (mParams->writeUnfiltered) {
-    TrackData trkDataTmp = trackData;
-    trkDataTmp.clIdx.setFirstEntry(mClResUnfiltered.size());
-    trkDataTmp.clIdx.setEntries(clusterResiduals.size());
-    mTrackDataUnfiltered.push_back(std::move(trkDataTmp));
-    mClResUnfiltered.insert(mClResUnfiltered.end(), clusterResiduals.begin(), clusterResiduals.end());
+    result.firstClResUnfiltered = buffers.clResUnfiltered.size();
+    result.nClResUnfiltered = clusterResiduals.size();
+    buffers.clResUnfiltered.insert(buffers.clResUnfiltered.end(), clusterResiduals.begin(), clusterResiduals.end());
   }
 }
 
-void TrackInterpolation::extrapolateTrack(int iSeed)
+void TrackInterpolation::extrapolateTrack(int iSeed, int iThread, SeedResult& result)
 {
   // extrapolate ITS-only track through TPC and store residuals to TPC clusters in the output vectors
   LOGP(debug, "Starting track extrapolation for GID {}", mGIDs[iSeed].asString());
   const auto& gidTable = mGIDtables[iSeed];
-  TrackData trackData;
+  auto& buffers = mThreadBuffers[iThread];
+  auto& trackData = result.trackData;
   std::unique_ptr<TrackDataExtended> trackDataExtended;
-  std::vector<TPCClusterResiduals> clusterResiduals;
-  trackData.clIdx.setFirstEntry(mClRes.size());
+  auto& clusterResiduals = buffers.clusterResiduals;
+  clusterResiduals.clear();
   const auto& trkITS = mRecoCont->getITSTrack(gidTable[GTrackID::ITS]);
   const auto& trkTPC = mRecoCont->getTPCTrack(gidTable[GTrackID::TPC]);
   if (mDumpTrackPoints) {
     trackDataExtended = std::make_unique<TrackDataExtended>();
     (*trackDataExtended).gid = mGIDs[iSeed];
-    (*trackDataExtended).clIdx.setFirstEntry(mClRes.size());
     (*trackDataExtended).trkITS = trkITS;
     (*trackDataExtended).trkTPC = trkTPC;
     auto nCl = trkITS.getNumberOfClusters();
@@ -615,7 +746,8 @@ void TrackInterpolation::extrapolateTrack(int iSeed)
   trackData.gid = mGIDs[iSeed];
   trackData.par = mSeeds[iSeed];
 
-  auto& trkWork = mSeeds[iSeed];
+  result.trkWork = mSeeds[iSeed];
+  auto& trkWork = result.trkWork;
   float clusterTimeBinOffset = mTrackTimes[iSeed] / mTPCTimeBinMUS;
   auto propagator = o2::base::Propagator::Instance();
   unsigned short rowPrev = 0; // used to calculate dRow of two consecutive cluster residuals
@@ -672,10 +804,12 @@ void TrackInterpolation::extrapolateTrack(int iSeed)
     LOGP(warn, "Extrapolated ITS-TPC track and found more reesiduals than possible ({})", clusterResiduals.size());
     return;
   }
+  result.thread = iThread;
   if (mParams->skipOutlierFiltering || validateTrack(trackData, params, clusterResiduals)) {
     // track is good
     int nClValidated = 0;
     int iRow = 0;
+    result.firstClRes = buffers.clRes.size();
     for (unsigned int iCl = 0; iCl < clusterResiduals.size(); ++iCl) {
       iRow += clusterResiduals[iCl].dRow;
       if (params.flagRej[iCl]) {
@@ -684,23 +818,20 @@ void TrackInterpolation::extrapolateTrack(int iSeed)
       }
       ++nClValidated;
       float tgPhi = clusterResiduals[iCl].snp / std::sqrt((1.f - clusterResiduals[iCl].snp) * (1.f + clusterResiduals[iCl].snp));
-      mClRes.emplace_back(clusterResiduals[iCl].dy, clusterResiduals[iCl].dz, tgPhi, clusterResiduals[iCl].y, clusterResiduals[iCl].z, iRow, clusterResiduals[iCl].sec);
+      buffers.clRes.emplace_back(clusterResiduals[iCl].dy, clusterResiduals[iCl].dz, tgPhi, clusterResiduals[iCl].y, clusterResiduals[iCl].z, iRow, clusterResiduals[iCl].sec);
     }
     trackData.clIdx.setEntries(nClValidated);
-    mTrackData.push_back(std::move(trackData));
-    mGIDsSuccess.push_back(mGIDs[iSeed]);
-    mTrackDataCompact.emplace_back(mClRes.size() - nClValidated, nClValidated, mGIDs[iSeed].getSource());
+    result.accepted = true;
     if (mDumpTrackPoints) {
       (*trackDataExtended).clIdx.setEntries(nClValidated);
-      mTrackDataExtended.push_back(std::move(*trackDataExtended));
+      result.extendedIdx = buffers.trackDataExtended.size();
+      buffers.trackDataExtended.push_back(std::move(*trackDataExtended));
     }
   }
   if (mParams->writeUnfiltered) {
-    TrackData trkDataTmp = trackData;
-    trkDataTmp.clIdx.setFirstEntry(mClResUnfiltered.size());
-    trkDataTmp.clIdx.setEntries(clusterResiduals.size());
-    mTrackDataUnfiltered.push_back(std::move(trkDataTmp));
-    mClResUnfiltered.insert(mClResUnfiltered.end(), clusterResiduals.begin(), clusterResiduals.end());
+    result.firstClResUnfiltered = buffers.clResUnfiltered.size();
+    result.nClResUnfiltered = clusterResiduals.size();
+    buffers.clResUnfiltered.insert(buffers.clResUnfiltered.end(), clusterResiduals.begin(), clusterResiduals.end());
   }
 }
 
@@ -1086,6 +1217,29 @@ void TrackInterpolation::reset()
   mGIDtables.clear();
   mTrackTimes.clear();
   mSeeds.clear();
+  for (auto& buffers : mThreadBuffers) {
+    buffers.clear();
+  }
+}
+
+void TrackInterpolation::ThreadBuffers::clear()
+{
+  clusterResiduals.clear();
+  clRes.clear();
+  clResUnfiltered.clear();
+  trackDataExtended.clear();
+}
+
+void TrackInterpolation::setNThreads(int n)
+{
+#ifndef WITH_OPENMP
+  if (n > 1) {
+    LOGP(warn, "{} threads requested for TrackInterpolation, but OpenMP is not available. Using 1 thread.", n);
+    n = 1;
+  }
+#endif
+  mNThreads = n > 0 ? n : 1;
+  mThreadBuffers.resize(mNThreads);
 }
 
 //______________________________________________
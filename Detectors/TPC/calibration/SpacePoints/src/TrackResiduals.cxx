@@ -21,9 +21,7 @@
 #include "ReconstructionDataFormats/Track.h"
 #include "MathUtils/fit.h"
 
-#include "TMatrixDSym.h"
-#include "TDecompChol.h"
-#include "TVectorD.h"
+#include "Math/CholeskyDecomp.h"
 
 #include <cmath>
 #include <cstring>
@@ -39,8 +37,56 @@
 
 #include <fairlogger/Logger.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::tpc;
 
+namespace
+{
+inline int getThreadID()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/// scratch vectors holding the residuals of one voxel at a time
+struct VoxelBuffer {
+  std::vector<float> dy;
+  std::vector<float> dz;
+  std::vector<float> tg;
+};
+
+/// Solves the system of linear equations mat * x = rhs in place, with the symmetric
+/// matrix given as packed lower triangle (m00, m10, m11, m20, ...)
+template <unsigned int N>
+bool solveCholesky(double* mat, double* rhs)
+{
+  ROOT::Math::CholeskyDecomp<double, N> decomp(mat);
+  return decomp.Solve(rhs);
+}
+
+bool solveCholesky(double* mat, double* rhs, int n)
+{
+  switch (n) {
+    case 4:
+      return solveCholesky<4>(mat, rhs);
+    case 5:
+      return solveCholesky<5>(mat, rhs);
+    case 6:
+      return solveCholesky<6>(mat, rhs);
+    case 7:
+      return solveCholesky<7>(mat, rhs);
+    default:
+      return false;
+  }
+}
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// initialization + binning
@@ -63,6 +109,18 @@ void TrackResiduals::init(bool doBinning)
   LOG(info) << "Initialization complete";
 }
 
+//______________________________________________________________________________
+void TrackResiduals::setNThreads(int n)
+{
+#ifndef WITH_OPENMP
+  if (n > 1) {
+    LOGP(warn, "{} threads requested for TrackResiduals, but OpenMP is not available. Using 1 thread.", n);
+    n = 1;
+  }
+#endif
+  mNThreads = n > 0 ? n : 1;
+}
+
 //______________________________________________________________________________
 void TrackResiduals::setY2XBinning(const std::vector<float>& binning)
 {
@@ -376,44 +434,43 @@ void TrackResiduals::processSectorResiduals(int iSec)
   // fill the voxel statistics into the results container
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
 
-  // vectors holding the data for one voxel at a time
-  std::vector<float> dyVec;
-  std::vector<float> dzVec;
-  std::vector<float> tgVec;
-  // assuming we will always have around 1000 entries per voxel
-  dyVec.reserve(1e3);
-  dzVec.reserve(1e3);
-  tgVec.reserve(1e3);
-  size_t currVoxBin = -1;
-  unsigned int nPointsInVox = 0;
-  unsigned int nProcessed = 0;
-  while (nProcessed < binData.size()) {
-    // read all points, voxel by voxel
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
-      }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
-      dyVec.clear();
-      dzVec.clear();
-      tgVec.clear();
+  // the points of the i-th voxel with data are binIndices[voxFirst[i]] ... binIndices[voxFirst[i + 1] - 1]
+  std::vector<unsigned int> voxFirst;
+  for (unsigned int i = 0; i < binIndices.size(); ++i) {
+    if (i == 0 || binData[binIndices[i]] != binData[binIndices[i - 1]]) {
+      voxFirst.push_back(i);
     }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    dzVec.push_back(mLocalResidualsIn[idx].dz * param::MaxResid / 0x7fff -
-                    mEffVdriftCorr * secData[currVoxBin].stat[VoxZ] * secData[currVoxBin].stat[VoxX] -
-                    effT0corr);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
-
-    ++nPointsInVox;
-    ++nProcessed;
   }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
+  int nVoxWithData = voxFirst.size();
+  voxFirst.push_back(binIndices.size());
+
+  // vectors holding the data for one voxel at a time, one set per thread
+  std::vector<VoxelBuffer> buffers(mNThreads);
+  for (auto& buffer : buffers) {
+    // assuming we will always have around 1000 entries per voxel
+    buffer.dy.reserve(1e3);
+    buffer.dz.reserve(1e3);
+    buffer.tg.reserve(1e3);
+  }
+#ifdef WITH_OPENMP
+  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
+    auto& buffer = buffers[getThreadID()];
+    buffer.dy.clear();
+    buffer.dz.clear();
+    buffer.tg.clear();
+    size_t voxBin = binData[binIndices[voxFirst[iVox]]];
+    for (unsigned int i = voxFirst[iVox]; i < voxFirst[iVox + 1]; ++i) {
+      int idx = binIndices[i];
+      buffer.dy.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
+      buffer.dz.push_back(mLocalResidualsIn[idx].dz * param::MaxResid / 0x7fff -
+                          mEffVdriftCorr * secData[voxBin].stat[VoxZ] * secData[voxBin].stat[VoxX] -
+                          effT0corr);
+      buffer.tg.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
+    }
+    processVoxelResiduals(buffer.dy, buffer.dz, buffer.tg, secData[voxBin]);
   }
   LOG(info) << "extracted residuals for sector " << iSec;
 
@@ -427,49 +484,35 @@ void TrackResiduals::processSectorResiduals(int iSec)
   }
 
   // process dispersions
-  dyVec.clear();
-  tgVec.clear();
-  currVoxBin = -1;
-  nProcessed = 0;
-  nPointsInVox = 0;
-  while (nProcessed < binData.size()) {
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-          processVoxelDispersions(tgVec, dyVec, resVox);
-        }
-      }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
-      dyVec.clear();
-      tgVec.clear();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int iVox = 0; iVox < nVoxWithData; ++iVox) {
+    VoxRes& resVox = secData[binData[binIndices[voxFirst[iVox]]]];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      continue;
     }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
-    VoxRes& resVox = secData[currVoxBin];
-    if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-      processVoxelDispersions(tgVec, dyVec, resVox);
+    auto& buffer = buffers[getThreadID()];
+    buffer.dy.clear();
+    buffer.tg.clear();
+    for (unsigned int i = voxFirst[iVox]; i < voxFirst[iVox + 1]; ++i) {
+      int idx = binIndices[i];
+      buffer.dy.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
+      buffer.tg.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
     }
+    processVoxelDispersions(buffer.tg, buffer.dy, resVox);
   }
   // smooth dispersions
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  int nVox = secData.size();
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int voxBin = 0; voxBin < nVox; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int iz = 0; iz < mNZ2XBins; ++iz) {
-      for (int ip = 0; ip < mNY2XBins; ++ip) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
-      }
-    }
+    getSmoothEstimate(iSec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, 0x1 << VoxV);
   }
   LOG(info) << "Done processing residuals for sector " << iSec;
   dumpResults(iSec);
@@ -687,44 +730,44 @@ int TrackResiduals::validateVoxels(int iSec)
 void TrackResiduals::smooth(int iSec)
 {
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  int nVox = secData.size();
+  // the flags of the neighbouring voxels are read during the smoothing, so they are only updated afterwards
+  std::vector<unsigned char> smoothDone(nVox, 0);
+  int nFailed = 0;
+#ifdef WITH_OPENMP
+  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads) reduction(+ : nFailed)
+#endif
+  for (int voxBin = 0; voxBin < nVox; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int ip = 0; ip < mNY2XBins; ++ip) {
-      for (int iz = 0; iz < mNZ2XBins; ++iz) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        resVox.flags &= ~SmoothDone;
-        bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
-        if (!res) {
-          mNSmoothingFailedBins[iSec]++;
-        } else {
-          resVox.flags |= SmoothDone;
-        }
-      }
+    bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
+    if (!res) {
+      nFailed++;
+    } else {
+      smoothDone[voxBin] = 1;
     }
   }
+  mNSmoothingFailedBins[iSec] += nFailed;
   // substract dX contribution to dZ
-  for (int ix = 0; ix < mNXBins; ++ix) {
-    if (getXBinIgnored(iSec, ix)) {
+  for (int voxBin = 0; voxBin < nVox; ++voxBin) {
+    VoxRes& resVox = secData[voxBin];
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
       continue;
     }
-    for (int ip = 0; ip < mNY2XBins; ++ip) {
-      for (int iz = 0; iz < mNZ2XBins; ++iz) {
-        int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        if (!(resVox.flags & SmoothDone)) {
-          continue;
-        }
-        resVox.DS[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX]; // remove slope*dX contribution from dZ
-        resVox.D[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX];  // remove slope*dX contribution from dZ
-      }
+    resVox.flags &= ~SmoothDone;
+    if (!smoothDone[voxBin]) {
+      continue;
     }
+    resVox.flags |= SmoothDone;
+    resVox.DS[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX]; // remove slope*dX contribution from dZ
+    resVox.D[ResZ] += resVox.stat[VoxZ] * resVox.DS[ResX];  // remove slope*dX contribution from dZ
   }
 }
 
-bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std::array<float, ResDim>& res, int whichDim)
+bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std::array<float, ResDim>& res, int whichDim) const
 {
   // get smooth estimate for distortions for point in sector coordinates
   /// \todo correct use of the symmetric matrix should speed up the code
@@ -750,16 +793,17 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
 
   int ix0, ip0, iz0;
   findVoxel(x, p, iSec < SECTORSPERSIDE ? z : -z, ix0, ip0, iz0); // find nearest voxel
-  std::vector<VoxRes>& secData = mVoxelResults[iSec];
-  int binCenter = getGlbVoxBin(ix0, ip0, iz0); // global bin of nearest voxel
-  VoxRes& voxCenter = secData[binCenter];      // nearest voxel
+  const std::vector<VoxRes>& secData = mVoxelResults[iSec];
+  int binCenter = getGlbVoxBin(ix0, ip0, iz0);  // global bin of nearest voxel
+  const VoxRes& voxCenter = secData[binCenter]; // nearest voxel
   LOG(debug) << "getting smooth estimate around voxel " << binCenter;
 
   // cache
   // \todo maybe a 1-D cache would be more efficient?
   std::array<std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>, ResDim> cmat;
+  std::array<double, ResDim * sMaxSmtDim> rhs;
   int maxNeighb = 10 * 10 * 10;
-  std::vector<VoxRes*> currVox;
+  std::vector<const VoxRes*> currVox;
   currVox.reserve(maxNeighb);
   std::vector<float> currCache;
   currCache.reserve(maxNeighb * VoxHDim);
@@ -772,7 +816,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   std::array<int, VoxDim> trial{0};
 
   while (true) {
-    std::fill(mLastSmoothingRes.begin(), mLastSmoothingRes.end(), 0);
+    rhs.fill(0);
     memset(&cmat[0][0], 0, sizeof(cmat));
 
     int nbOK = 0; // accounted neighbours
@@ -851,7 +895,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       for (int ip = ipMin; ip <= ipMax; ++ip) {
         for (int iz = izMin; iz <= izMax; ++iz) {
           int binNb = getGlbVoxBin(ix, ip, iz);
-          VoxRes& voxNb = secData[binNb];
+          const VoxRes& voxNb = secData[binNb];
           if (!(voxNb.flags & DistDone) ||
               (voxNb.flags & Masked) ||
               getXBinIgnored(iSec, ix)) {
@@ -958,7 +1002,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
           wi /= (voxNb->E[iDim] * voxNb->E[iDim]);
         }
         std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-        double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+        double* rhsD = &rhs[iDim * sMaxSmtDim];
         unsigned short iMat = 0;
         unsigned short iRhs = 0;
         // linear part
@@ -1011,74 +1055,20 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       }
     }
 
-    bool fitRes = true;
-
-    // solve system of linear equations
-
-    TMatrixDSym matrix(matSize);
-    TDecompChol chol(matSize);
-    TVectorD rhsVec(matSize);
+    // solve system of linear equations, cmat holds the lower triangle of the symmetric matrix
     for (int iDim = 0; iDim < ResDim; ++iDim) {
       if (!doDim[iDim]) {
         continue;
       }
-      matrix.Zero(); // reset matrix
-      std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-      double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
-      short iMat = -1;
-      short row = -1;
-
-      // with the studid implementation of TMatrixDSym we need to set all elements of the matrix explicitly (or maybe only upper triangle?)
-      matrix(++row, 0) = cmatD[++iMat];
-      matrix(++row, 0) = cmatD[++iMat];
-      matrix(row, 1) = cmatD[++iMat];
-      matrix(0, row) = matrix(row, 0);
-      matrix(++row, 0) = cmatD[++iMat];
-      matrix(row, 1) = cmatD[++iMat];
-      matrix(row, 2) = cmatD[++iMat];
-      matrix(0, row) = matrix(row, 0);
-      matrix(1, row) = matrix(row, 1);
-      matrix(++row, 0) = cmatD[++iMat];
-      matrix(row, 1) = cmatD[++iMat];
-      matrix(row, 2) = cmatD[++iMat];
-      matrix(row, 3) = cmatD[++iMat];
-      matrix(0, row) = matrix(row, 0);
-      matrix(1, row) = matrix(row, 1);
-      matrix(2, row) = matrix(row, 2);
-      // add pol2 elements if needed
-      if (mSmoothPol2[VoxX]) {
-        const int colLim = (++row) + 1;
-        for (int iCol = 0; iCol < colLim; ++iCol) {
-          matrix(row, iCol) = cmatD[++iMat];
-          matrix(iCol, row) = matrix(row, iCol);
-        }
-      }
-      if (mSmoothPol2[VoxF]) {
-        const int colLim = (++row) + 1;
-        for (int iCol = 0; iCol < colLim; ++iCol) {
-          matrix(row, iCol) = cmatD[++iMat];
-          matrix(iCol, row) = matrix(row, iCol);
-        }
-      }
-      if (mSmoothPol2[VoxZ]) {
-        const int colLim = (++row) + 1;
-        for (int iCol = 0; iCol < colLim; ++iCol) {
-          matrix(row, iCol) = cmatD[++iMat];
-          matrix(iCol, row) = matrix(row, iCol);
-        }
-      }
-      rhsVec.SetElements(rhsD);
-      chol.SetMatrix(matrix);
-      chol.Decompose();
-      fitRes = chol.Solve(rhsVec);
-      if (!fitRes) {
+      double* rhsD = &rhs[iDim * sMaxSmtDim];
+      if (!solveCholesky(cmat[iDim].data(), rhsD, matSize)) {
         for (int i = VoxDim; i--;) {
           trial[i]++;
         }
         LOG(error) << "solution for smoothing failed, trying to increase filter bandwidth";
         continue;
       }
-      res[iDim] = rhsVec[0];
+      res[iDim] = rhsD[0];
     }
 
     break;
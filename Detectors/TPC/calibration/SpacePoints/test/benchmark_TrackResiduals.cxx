@@ -0,0 +1,108 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief time needed by TrackResiduals::processSectorResiduals vs number of threads
+// The binned residuals of sector 0 are taken from the file given by the O2_TPC_RESIDUALS_FILE
+// environment variable (resid and stats trees as written by the residual aggregator).
+// If it is not set, residuals are generated randomly for every voxel.
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+#include "SpacePoints/TrackResiduals.h"
+#include "TFile.h"
+#include "TTree.h"
+
+using namespace o2::tpc;
+
+constexpr int Sector = 0;
+
+struct SectorInput {
+  std::vector<TrackResiduals::LocalResid> residuals;
+  std::vector<TrackResiduals::VoxStats> stats;
+};
+
+bool readInput(TrackResiduals& trackResiduals, const char* fileName, SectorInput& input)
+{
+  std::unique_ptr<TFile> file(TFile::Open(fileName));
+  if (!file || file->IsZombie()) {
+    return false;
+  }
+  auto treeResid = (TTree*)file->Get("resid");
+  auto treeStats = (TTree*)file->Get("stats");
+  if (!treeResid || !treeStats) {
+    return false;
+  }
+  std::vector<TrackResiduals::VoxStats>* statsPtr = &input.stats;
+  treeStats->SetBranchAddress(Form("sec%d", Sector), &statsPtr);
+  treeStats->GetEntry(treeStats->GetEntries() - 1);
+  std::vector<TrackResiduals::LocalResid> residuals, *residualsPtr = &residuals;
+  treeResid->SetBranchAddress(Form("sec%d", Sector), &residualsPtr);
+  for (int iEntry = 0; iEntry < treeResid->GetEntries(); ++iEntry) {
+    treeResid->GetEntry(iEntry);
+    input.residuals.insert(input.residuals.end(), residuals.begin(), residuals.end());
+  }
+  return (int)input.stats.size() == trackResiduals.getNVoxelsPerSector();
+}
+
+void createInput(TrackResiduals& trackResiduals, int nPerVoxel, SectorInput& input)
+{
+  std::mt19937 gen(12345);
+  std::normal_distribution<float> gaus(0., 1.);
+  input.stats.resize(trackResiduals.getNVoxelsPerSector());
+  for (int ix = 0; ix < trackResiduals.getNXBins(); ++ix) {
+    for (int ip = 0; ip < trackResiduals.getNY2XBins(); ++ip) {
+      for (int iz = 0; iz < trackResiduals.getNZ2XBins(); ++iz) {
+        auto& stat = input.stats[trackResiduals.getGlbVoxBin(ix, ip, iz)];
+        trackResiduals.getVoxelCoordinates(Sector, ix, ip, iz, stat.meanPos[TrackResiduals::VoxX], stat.meanPos[TrackResiduals::VoxF], stat.meanPos[TrackResiduals::VoxZ]);
+        stat.nEntries = nPerVoxel;
+        std::array<unsigned char, TrackResiduals::VoxDim> bvox;
+        bvox[TrackResiduals::VoxX] = ix;
+        bvox[TrackResiduals::VoxF] = ip;
+        bvox[TrackResiduals::VoxZ] = iz;
+        for (int i = 0; i < nPerVoxel; ++i) {
+          // ~1 mm spread for dy/dz around a small offset, tgSlp within +-0.2
+          input.residuals.emplace_back(300 + 300 * gaus(gen), -200 + 300 * gaus(gen), 3000 * gaus(gen), bvox);
+        }
+      }
+    }
+  }
+}
+
+// state.range: 0 - number of threads
+static void BM_ProcessSectorResiduals(benchmark::State& state)
+{
+  TrackResiduals trackResiduals;
+  trackResiduals.init();
+  trackResiduals.setNThreads(state.range(0));
+  SectorInput input;
+  const char* fileName = std::getenv("O2_TPC_RESIDUALS_FILE");
+  if (!fileName || !readInput(trackResiduals, fileName, input)) {
+    input = SectorInput{};
+    createInput(trackResiduals, 50, input);
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    trackResiduals.reset();
+    trackResiduals.clear();
+    trackResiduals.getLocalResVec() = input.residuals;
+    trackResiduals.setStats(input.stats, Sector);
+    state.ResumeTiming();
+    trackResiduals.processSectorResiduals(Sector);
+  }
+  state.SetItemsProcessed(state.iterations() * input.residuals.size());
+}
+
+BENCHMARK(BM_ProcessSectorResiduals)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
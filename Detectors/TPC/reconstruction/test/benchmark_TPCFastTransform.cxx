@@ -0,0 +1,132 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+// @brief time needed to transform the clusters of a TF with TPCFastTransform::Transform vs TPCFastTransform::TransformBatch
+// The clusters are read from the file given by the O2_TPC_CLUSTERS_FILE environment variable (tpc-native-clusters.root),
+// otherwise they are generated randomly. The transformation is loaded from the file given by O2_TPC_FASTTRANSFORM_FILE,
+// otherwise the default one w/o space charge distortions is used.
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "DataFormatsTPC/ClusterNative.h"
+#include "DataFormatsTPC/ClusterNativeHelper.h"
+#include "DataFormatsTPC/Constants.h"
+#include "TPCReconstruction/TPCFastTransformHelperO2.h"
+#include "TPCFastTransform.h"
+
+using namespace o2::tpc;
+using namespace o2::gpu;
+
+struct SectorClusters {
+  std::vector<int> row;
+  std::vector<float> pad;
+  std::vector<float> time;
+};
+
+bool readClusters(const char* fileName, std::vector<SectorClusters>& sectors)
+{
+  ClusterNativeHelper::Reader reader;
+  reader.init(fileName);
+  if (!reader.getTreeSize()) {
+    return false;
+  }
+  ClusterNativeAccess clusterIndex;
+  std::unique_ptr<ClusterNative[]> clusterBuffer;
+  memset(&clusterIndex, 0, sizeof(clusterIndex));
+  ClusterNativeHelper::ConstMCLabelContainerViewWithBuffer clusterMCBuffer;
+  reader.read(0);
+  reader.fillIndex(clusterIndex, clusterBuffer, clusterMCBuffer);
+  for (int sector = 0; sector < constants::MAXSECTOR; sector++) {
+    auto& clusters = sectors[sector];
+    for (int row = 0; row < constants::MAXGLOBALPADROW; row++) {
+      for (unsigned int icl = 0; icl < clusterIndex.nClusters[sector][row]; icl++) {
+        const auto& cl = clusterIndex.clusters[sector][row][icl];
+        clusters.row.push_back(row);
+        clusters.pad.push_back(cl.getPad());
+        clusters.time.push_back(cl.getTime());
+      }
+    }
+  }
+  return clusterIndex.nClustersTotal > 0;
+}
+
+void createClusters(const TPCFastTransform& transform, int nPerRow, std::vector<SectorClusters>& sectors)
+{
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<float> uniform(0.f, 1.f);
+  const auto& geo = transform.getGeometry();
+  for (auto& clusters : sectors) {
+    for (int row = 0; row < geo.getNumberOfRows(); row++) {
+      for (int icl = 0; icl < nPerRow; icl++) {
+        clusters.row.push_back(row);
+        clusters.pad.push_back(uniform(gen) * geo.getRowInfo(row).maxPad);
+        clusters.time.push_back(uniform(gen) * 5000.f);
+      }
+    }
+  }
+}
+
+std::unique_ptr<TPCFastTransform> createTransform()
+{
+  const char* fileName = std::getenv("O2_TPC_FASTTRANSFORM_FILE");
+  if (fileName) {
+    std::unique_ptr<TPCFastTransform> transform(TPCFastTransform::loadFromFile(fileName));
+    if (transform) {
+      return transform;
+    }
+  }
+  return TPCFastTransformHelperO2::instance()->create(0);
+}
+
+// state.range: 0 - use the batch transformation
+static void BM_TransformTF(benchmark::State& state)
+{
+  auto transform = createTransform();
+  std::vector<SectorClusters> sectors(constants::MAXSECTOR);
+  const char* fileName = std::getenv("O2_TPC_CLUSTERS_FILE");
+  if (!fileName || !readClusters(fileName, sectors)) {
+    sectors.assign(constants::MAXSECTOR, SectorClusters{});
+    createClusters(*transform, 500, sectors);
+  }
+  size_t nClusters = 0;
+  for (const auto& clusters : sectors) {
+    nClusters += clusters.row.size();
+  }
+  std::vector<float> x(nClusters), y(nClusters), z(nClusters);
+  const bool batch = state.range(0);
+  for (auto _ : state) {
+    size_t offset = 0;
+    for (int sector = 0; sector < constants::MAXSECTOR; sector++) {
+      const auto& clusters = sectors[sector];
+      const int n = clusters.row.size();
+      if (batch) {
+        transform->TransformBatch(sector, n, clusters.row.data(), clusters.pad.data(), clusters.time.data(), &x[offset], &y[offset], &z[offset]);
+      } else {
+        for (int i = 0; i < n; i++) {
+          transform->Transform(sector, clusters.row[i], clusters.pad[i], clusters.time[i], x[offset + i], y[offset + i], z[offset + i]);
+        }
+      }
+      offset += n;
+    }
+    benchmark::DoNotOptimize(x.data());
+    benchmark::DoNotOptimize(y.data());
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * nClusters);
+}
+
+BENCHMARK(BM_TransformTF)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
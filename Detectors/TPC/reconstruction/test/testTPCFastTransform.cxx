@@ -30,6 +30,8 @@
 #include <fairlogger/Logger.h>
 
 #include <vector>
+#include <random>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -94,6 +96,87 @@ BOOST_AUTO_TEST_CASE(FastTransform_test1)
   BOOST_CHECK(fabs(maxDy) < 1.e-5);
 }
 
+/// create a transformation with random space charge correction on the given geometry
+std::unique_ptr<TPCFastTransform> createRandomCorrectionTransform(const TPCFastTransformGeo& geo, int seed)
+{
+  TPCFastSpaceChargeCorrection correction;
+  correction.startConstruction(geo, 1);
+  for (int row = 0; row < geo.getNumberOfRows(); row++) {
+    correction.setRowScenarioID(row, 0);
+  }
+  TPCFastSpaceChargeCorrection::SplineType spline;
+  spline.recreate(10, 20);
+  correction.setSplineScenario(0, spline);
+  correction.finishConstruction();
+  correction.setNoCorrection();
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> uniform(-0.5f, 0.5f);
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice++) {
+    for (int row = 0; row < geo.getNumberOfRows(); row++) {
+      float* data = correction.getSplineData(slice, row);
+      int nPar = correction.getSpline(slice, row).getNumberOfParameters();
+      for (int i = 0; i < nPar; i++) {
+        data[i] = uniform(gen);
+      }
+      correction.getSliceRowInfo(slice, row).gridV0 = (row % 3) * 5.f;
+    }
+  }
+  auto transform = std::make_unique<TPCFastTransform>();
+  transform->startConstruction(correction);
+  transform->setApplyCorrectionOn();
+  transform->setCalibration(0, 5.f, 0.25f, 1.e-4f, 0.1f, 1.e-3f, 0.5f);
+  transform->finishConstruction();
+  return transform;
+}
+
+/// @brief TransformBatch must give the same result as Transform for every cluster
+BOOST_AUTO_TEST_CASE(FastTransform_testBatch)
+{
+  std::unique_ptr<TPCFastTransform> fastTransform0(TPCFastTransformHelperO2::instance()->create(0));
+  const TPCFastTransformGeo& geo = fastTransform0->getGeometry();
+  auto transform = createRandomCorrectionTransform(geo, 1);
+  auto ref = createRandomCorrectionTransform(geo, 2);
+  auto ref2 = createRandomCorrectionTransform(geo, 3);
+
+  // clusters grouped by row, as in the TPC cluster index, with some rows out of order and pads/times out of range
+  std::mt19937 gen(7);
+  std::vector<int> rows;
+  std::vector<float> pads, times;
+  for (int row = 0; row < geo.getNumberOfRows(); row++) {
+    std::uniform_real_distribution<float> padGen(-2.f, geo.getRowInfo(row).maxPad + 2.f), timeGen(-100.f, 1100.f);
+    for (int icl = 0; icl < 50; icl++) {
+      rows.push_back(row);
+      pads.push_back(padGen(gen));
+      times.push_back(timeGen(gen));
+    }
+  }
+  std::swap(rows[5], rows[500]);
+  std::swap(rows[6], rows[2000]);
+  const int n = rows.size();
+  std::vector<float> x0(n), y0(n), z0(n), x1(n), y1(n), z1(n);
+
+  struct RefConfig {
+    const TPCFastTransform* ref;
+    const TPCFastTransform* ref2;
+    float scale, scale2;
+    int scaleMode;
+  };
+  const RefConfig configs[] = {{nullptr, nullptr, 0.f, 0.f, 0}, {ref.get(), nullptr, 0.7f, 0.f, 0}, {ref.get(), ref2.get(), 0.3f, 0.5f, 1}, {ref.get(), nullptr, -1.f, 0.f, 0}, {ref.get(), nullptr, 0.4f, 0.f, 2}};
+  for (const auto& cfg : configs) {
+    for (int slice : {3, 25}) {
+      for (int i = 0; i < n; i++) {
+        transform->Transform(slice, rows[i], pads[i], times[i], x0[i], y0[i], z0[i], 1.5f, cfg.ref, cfg.ref2, cfg.scale, cfg.scale2, cfg.scaleMode);
+      }
+      transform->TransformBatch(slice, n, rows.data(), pads.data(), times.data(), x1.data(), y1.data(), z1.data(), 1.5f, cfg.ref, cfg.ref2, cfg.scale, cfg.scale2, cfg.scaleMode);
+      float maxDiff = 0.f;
+      for (int i = 0; i < n; i++) {
+        maxDiff = std::max({maxDiff, std::abs(x1[i] - x0[i]), std::abs(y1[i] - y0[i]), std::abs(z1[i] - z0[i])});
+      }
+      BOOST_CHECK_MESSAGE(maxDiff < 1.e-4, "TransformBatch differs from Transform by " << maxDiff << " cm for slice " << slice << " scale mode " << cfg.scaleMode << " scale " << cfg.scale);
+    }
+  }
+}
+
 #ifdef XXX
 BOOST_AUTO_TEST_CASE(FastTransform_test_setSpaceChargeCorrection)
 {
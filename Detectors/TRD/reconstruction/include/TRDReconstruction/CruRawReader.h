@@ -100,6 +100,13 @@ class CruRawReader
   // reset the event storage and the counters
   void reset();
 
+  // take over the configuration and the state carried between TFs of another reader, so that this one can decode a share of the input
+  // as worker iWorker out of nWorkers, which also get their share of the InfoLogger budget of the other reader
+  void copySettingsFrom(const CruRawReader& other, int iWorker, int nWorkers);
+
+  // add the data, statistics and error counters decoded by another reader (e.g. by a worker thread), afterwards the other reader is reset
+  void mergeFrom(CruRawReader& other);
+
   // the parsing starts here, payload from all available RDHs is copied into mHBFPayload and afterwards processHalfCRU() is called
   // returns the total number of bytes read, including RDH header
   int processHBFs();
@@ -162,6 +169,8 @@ class CruRawReader
   // InfoLogger flood protection settings
   int mMaxErrsPrinted = 20;
   int mMaxWarnPrinted = 20;
+  int mMaxErrsGranted = 0; // the budgets received with copySettingsFrom, to account for the consumption in mergeFrom
+  int mMaxWarnGranted = 0;
 
   // helper pointers, counters for the input buffer
   const char* mDataBufferPtr = nullptr; // pointer to the beginning of the whole payload data
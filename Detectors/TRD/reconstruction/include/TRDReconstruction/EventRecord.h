@@ -64,6 +64,9 @@ class EventRecord
   void incTime(float duration) { mTimeTaken += duration; }
   void setIsCalibTrigger() { mIsCalibTrigger = true; }
 
+  // add the data and counters of another record for the same interaction, decoded e.g. by another thread
+  void merge(EventRecord& other);
+
  private:
   BCData mBCData;                       /// orbit and Bunch crossing data of the physics trigger
   std::vector<Digit> mDigits{};         /// digit data, for this event
@@ -111,6 +114,9 @@ class EventRecordContainer
   void reset();
   void accumulateStats();
 
+  // add the event records and statistics of another container, the records of interactions not yet known are appended in their order
+  void merge(EventRecordContainer& other);
+
  private:
   int mCurrEventRecord = 0;
   std::vector<EventRecord> mEventRecords;
@@ -34,6 +34,7 @@
 #include <string>
 #include <numeric>
 #include <iomanip>
+#include <algorithm>
 
 using namespace o2::trd::constants;
 
@@ -1156,6 +1157,51 @@ void CruRawReader::reset()
   mWordsRejected = 0;
 }
 
+void CruRawReader::copySettingsFrom(const CruRawReader& other, int iWorker, int nWorkers)
+{
+  configure(other.mTrackletHCHeaderState, other.mHalfChamberWords, other.mHalfChamberMajor, other.mOptions);
+  // the InfoLogger budget left is split between the workers, so that together they do not print more than a single reader
+  auto share = [iWorker, nWorkers](int budget) {
+    return budget == std::numeric_limits<int>::max() ? budget : std::max(budget, 0) / nWorkers + (iWorker < std::max(budget, 0) % nWorkers);
+  };
+  mMaxErrsPrinted = mMaxErrsGranted = share(other.mMaxErrsPrinted);
+  mMaxWarnPrinted = mMaxWarnGranted = share(other.mMaxWarnPrinted);
+  mTimeBins = other.mTimeBins;
+  mTimeBinsFixed = other.mTimeBinsFixed;
+  mHaveSeenDigitHCHeader3 = other.mHaveSeenDigitHCHeader3;
+  mPreviousDigitHCHeadersvnver = other.mPreviousDigitHCHeadersvnver;
+  mPreviousDigitHCHeadersvnrver = other.mPreviousDigitHCHeadersvnrver;
+  mLinkMap = other.mLinkMap;
+}
+
+void CruRawReader::mergeFrom(CruRawReader& other)
+{
+  mEventRecords.merge(other.mEventRecords);
+  mTrackletsFound += other.mTrackletsFound;
+  mDigitsFound += other.mDigitsFound;
+  mDigitWordsRead += other.mDigitWordsRead;
+  mDigitWordsRejected += other.mDigitWordsRejected;
+  mTrackletWordsRead += other.mTrackletWordsRead;
+  mTrackletWordsRejected += other.mTrackletWordsRejected;
+  mWordsRejected += other.mWordsRejected;
+  mHalfChamberHeaderOK.insert(other.mHalfChamberHeaderOK.begin(), other.mHalfChamberHeaderOK.end());
+  mHalfChamberMismatches.insert(other.mHalfChamberMismatches.begin(), other.mHalfChamberMismatches.end());
+  other.mHalfChamberHeaderOK.clear();
+  other.mHalfChamberMismatches.clear();
+  // the InfoLogger budget is shared: subtract what the other reader consumed of its share
+  auto consume = [](int budget, int granted, int left) {
+    return budget == std::numeric_limits<int>::max() ? budget : budget - (granted - std::max(left, 0));
+  };
+  mMaxErrsPrinted = consume(mMaxErrsPrinted, other.mMaxErrsGranted, other.mMaxErrsPrinted);
+  mMaxWarnPrinted = consume(mMaxWarnPrinted, other.mMaxWarnGranted, other.mMaxWarnPrinted);
+  if (!mHaveSeenDigitHCHeader3 && other.mHaveSeenDigitHCHeader3) {
+    mHaveSeenDigitHCHeader3 = true;
+    mPreviousDigitHCHeadersvnver = other.mPreviousDigitHCHeadersvnver;
+    mPreviousDigitHCHeadersvnrver = other.mPreviousDigitHCHeadersvnrver;
+  }
+  other.reset();
+}
+
 void CruRawReader::checkNoWarn(bool silently)
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
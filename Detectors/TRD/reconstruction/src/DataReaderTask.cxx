@@ -26,6 +26,9 @@
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DataFormatsTRD/Constants.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace o2::trd
 {
 
@@ -39,6 +42,17 @@ void DataReaderTask::init(InitContext& ic)
   }
   mReader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
   mProcessEveryNthTF = ic.options().get<int>("every-nth-tf");
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "OpenMP is not available, the raw data is decoded with a single thread";
+    mNThreads = 1;
+  }
+#endif
+  for (int i = 0; i < (mNThreads > 1 ? mNThreads : 0); ++i) {
+    mWorkerReaders.emplace_back(std::make_unique<CruRawReader>());
+  }
+  LOG(info) << "Raw data decoding running with " << mNThreads << " threads";
 }
 
 void DataReaderTask::endOfStream(o2::framework::EndOfStreamContext& ec)
@@ -113,22 +127,49 @@ void DataReaderTask::run(ProcessingContext& pc)
   size_t datasizeInTF = 0;
   std::vector<InputSpec> sel{InputSpec{"filter", ConcreteDataTypeMatcher{"TRD", "RAWDATA"}}};
   uint64_t tfCount = 0;
+  std::vector<std::pair<const char*, size_t>> payloads; // the input of every half-CRU, decoded independently
   for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
     // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
     tfCount = dh->tfCounter;
-    const char* payloadIn = ref.payload;
     auto payloadInSize = DataRefUtils::getPayloadSize(ref);
     if (mOptions[TRDVerboseBit]) {
       LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
            dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
     }
-    mReader.setDataBuffer(payloadIn);
-    mReader.setDataBufferSize(payloadInSize);
-    mReader.run();
+    payloads.emplace_back(ref.payload, payloadInSize);
     datasizeInTF += payloadInSize;
+  }
+
+  auto decode = [this](CruRawReader& reader, const std::pair<const char*, size_t>& payload) {
+    reader.setDataBuffer(payload.first);
+    reader.setDataBufferSize(payload.second);
+    reader.run();
     if (mOptions[TRDVerboseBit]) {
-      LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+      LOG(info) << "relevant vectors to read : " << reader.getTrackletsFound() << " tracklets and " << reader.getDigitsFound() << " compressed digits";
+    }
+  };
+  if (mNThreads == 1) {
+    for (const auto& payload : payloads) {
+      decode(mReader, payload);
+    }
+  } else {
+    // every worker decodes a contiguous block of half-CRUs into its own event records, which are merged in the order of the workers,
+    // so that the output does not depend on the scheduling
+    int nWorkers = mWorkerReaders.size();
+    for (int iWorker = 0; iWorker < nWorkers; ++iWorker) {
+      mWorkerReaders[iWorker]->copySettingsFrom(mReader, iWorker, nWorkers);
+    }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(mNThreads)
+#endif
+    for (int iWorker = 0; iWorker < nWorkers; ++iWorker) {
+      for (size_t i = payloads.size() * iWorker / nWorkers; i < payloads.size() * (iWorker + 1) / nWorkers; ++i) {
+        decode(*mWorkerReaders[iWorker], payloads[i]);
+      }
+    }
+    for (auto& worker : mWorkerReaders) {
+      mReader.mergeFrom(*worker);
     }
   }
 
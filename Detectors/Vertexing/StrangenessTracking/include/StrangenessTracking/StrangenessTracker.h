@@ -83,6 +83,7 @@ class StrangenessTracker
   bool matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, const TrackITS& itsTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread = 0);
   void prepareITStracks();
   void process();
+  void mergeThreadOutputs();
   void processV0(int iv0, const V0& v0, const V0Index& v0Idx, int iThread = 0);
   void processCascade(int icasc, const Cascade& casc, const CascadeIndex& cascIdx, const V0& cascV0, int iThread = 0);
   void process3Body(int i3body, const Decay3Body& dec3body, const Decay3BodyIndex& dec3bodyIdx, int iThread = 0);
@@ -93,6 +94,7 @@ class StrangenessTracker
   std::vector<o2::MCCompLabel>& getStrangeTrackLabels(int iThread = 0) { return mStrangeTrackLabels[iThread]; };
   size_t getNTracks(int ithread = 0) const { return ithread < (int)mStrangeTrackVec.size() ? mStrangeTrackVec[ithread].size() : 0; }
 
+  int getNThreads() const { return mNThreads; }
   float getBz() const { return mBz; }
   void setBz(float d) { mBz = d; }
   void setClusterDictionary(const o2::itsmft::TopologyDictionary* d) { mDict = d; }
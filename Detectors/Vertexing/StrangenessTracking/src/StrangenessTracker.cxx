@@ -12,14 +12,31 @@
 /// \brief
 
 #include <numeric>
+#include <algorithm>
 #include "StrangenessTracking/StrangenessTracker.h"
 #include "ITStracking/IOUtils.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace strangeness_tracking
 {
 
+namespace
+{
+inline int getThreadID()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
 bool StrangenessTracker::loadData(const o2::globaltracking::RecoContainer& recoData)
 {
   clear();
@@ -299,25 +316,92 @@ void StrangenessTracker::process3Body(int i3Body, const Decay3Body& dec3body, co
 
 void StrangenessTracker::process()
 {
+  // every decay candidate is matched independently against the (read-only) ITS track index table,
+  // each thread uses its own fitters and output containers
+  const int nV0s = mInputV0tracks.size(), nCascs = mInputCascadeTracks.size(), n3Bodys = mStrParams->mSkip3Body ? 0 : mInput3BodyTracks.size();
+#ifdef WITH_OPENMP
+  int dynGrp = std::min(4, std::max(1, mNThreads / 2));
+#endif
+
   // Loop over V0s
-  for (int iV0{0}; iV0 < mInputV0tracks.size(); iV0++) {
-    LOG(debug) << "Analysing V0: " << iV0 + 1 << "/" << mInputV0tracks.size();
-    processV0(iV0, mInputV0tracks[iV0], mInputV0Indices[iV0]);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int iV0 = 0; iV0 < nV0s; iV0++) {
+    LOG(debug) << "Analysing V0: " << iV0 + 1 << "/" << nV0s;
+    processV0(iV0, mInputV0tracks[iV0], mInputV0Indices[iV0], getThreadID());
   }
 
   // Loop over Cascades
-  for (int iCasc{0}; iCasc < mInputCascadeTracks.size(); iCasc++) {
-    LOG(debug) << "Analysing Cascade: " << iCasc + 1 << "/" << mInputCascadeTracks.size();
-    processCascade(iCasc, mInputCascadeTracks[iCasc], mInputCascadeIndices[iCasc], mInputV0tracks[mInputCascadeIndices[iCasc].getV0ID()]);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int iCasc = 0; iCasc < nCascs; iCasc++) {
+    LOG(debug) << "Analysing Cascade: " << iCasc + 1 << "/" << nCascs;
+    processCascade(iCasc, mInputCascadeTracks[iCasc], mInputCascadeIndices[iCasc], mInputV0tracks[mInputCascadeIndices[iCasc].getV0ID()], getThreadID());
   }
 
   // Loop over 3bodys
-  if (!mStrParams->mSkip3Body) {
-    for (int i3Body{0}; i3Body < mInput3BodyTracks.size(); i3Body++) {
-      LOG(debug) << "Analysing 3-Body: " << i3Body + 1 << "/" << mInput3BodyTracks.size();
-      process3Body(i3Body, mInput3BodyTracks[i3Body], mInput3BodyIndices[i3Body]);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic, dynGrp) num_threads(mNThreads)
+#endif
+  for (int i3Body = 0; i3Body < n3Bodys; i3Body++) {
+    LOG(debug) << "Analysing 3-Body: " << i3Body + 1 << "/" << n3Bodys;
+    process3Body(i3Body, mInput3BodyTracks[i3Body], mInput3BodyIndices[i3Body], getThreadID());
+  }
+
+  if (mNThreads > 1) {
+    mergeThreadOutputs();
+  }
+}
+
+void StrangenessTracker::mergeThreadOutputs()
+{
+  // Collect the outputs of all threads into the slot 0 containers, in the same order as the single-thread processing:
+  // decay type, then decay reference. All matches of a given candidate are produced by the same thread in the sequential
+  // order, hence a stable sort of the concatenated outputs reproduces the single-thread result.
+  struct Ref {
+    int thread, entry;
+  };
+  std::vector<Ref> refs;
+  size_t nTot = 0;
+  for (int ith = 0; ith < mNThreads; ith++) {
+    nTot += mStrangeTrackVec[ith].size();
+  }
+  refs.reserve(nTot);
+  for (int ith = 0; ith < mNThreads; ith++) {
+    for (int i = 0; i < (int)mStrangeTrackVec[ith].size(); i++) {
+      refs.push_back({ith, i});
     }
   }
+  std::stable_sort(refs.begin(), refs.end(), [this](const Ref& a, const Ref& b) {
+    const auto &ta = mStrangeTrackVec[a.thread][a.entry], &tb = mStrangeTrackVec[b.thread][b.entry];
+    return ta.mPartType < tb.mPartType || (ta.mPartType == tb.mPartType && ta.mDecayRef < tb.mDecayRef);
+  });
+
+  std::vector<StrangeTrack> strTracks;
+  std::vector<ClusAttachments> strClus;
+  std::vector<o2::MCCompLabel> strLabels;
+  strTracks.reserve(nTot);
+  strClus.reserve(nTot);
+  if (mMCTruthON) {
+    strLabels.reserve(nTot);
+  }
+  for (const auto& ref : refs) {
+    strTracks.push_back(mStrangeTrackVec[ref.thread][ref.entry]);
+    strClus.push_back(mClusAttachments[ref.thread][ref.entry]);
+    if (mMCTruthON) {
+      strLabels.push_back(mStrangeTrackLabels[ref.thread][ref.entry]);
+    }
+  }
+  for (int ith = 1; ith < mNThreads; ith++) {
+    mStrangeTrackVec[ith].clear();
+    mClusAttachments[ith].clear();
+    mStrangeTrackLabels[ith].clear();
+  }
+  mStrangeTrackVec[0].swap(strTracks);
+  mClusAttachments[0].swap(strClus);
+  mStrangeTrackLabels[0].swap(strLabels);
 }
 
 bool StrangenessTracker::matchDecayToITStrack(float decayR, StrangeTrack& strangeTrack, ClusAttachments& structClus, const TrackITS& itsTrack, std::vector<o2::track::TrackParCovF>& daughterTracks, int iThread)
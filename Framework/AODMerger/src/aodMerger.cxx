@@ -254,6 +254,36 @@ int main(int argc, char* argv[])
         }
 
         auto outputTree = trees[treeName];
+
+        // for trees which were cloned above, only the minimum unassigned index is needed: without VLA columns
+        // and index slices, only the index columns are read, in bulk
+        bool readIndexOnly = alreadyCopied && !hasVLA(inputTree);
+        std::vector<TBranch*> indexBranches;
+        for (auto obj : *inputTree->GetListOfBranches()) {
+          TString branchName(obj->GetName());
+          if (branchName.BeginsWith("fIndexSlice")) {
+            readIndexOnly = false;
+          } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
+            indexBranches.push_back((TBranch*)obj);
+          }
+        }
+
+        if (readIndexOnly) {
+          int minIndexOffset = unassignedIndexOffset[treeName];
+          auto newMinIndexOffset = minIndexOffset;
+          for (auto br : indexBranches) {
+            for (auto value : readBranch<int>(br)) {
+              // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
+              if (value < 0) {
+                newMinIndexOffset = std::min(newMinIndexOffset, value + minIndexOffset);
+              }
+            }
+          }
+          unassignedIndexOffset[treeName] = newMinIndexOffset;
+          delete inputTree;
+          continue;
+        }
+
         // register index and connect VLA columns
         std::vector<std::pair<int*, int>> indexList;
         std::vector<char*> vlaPointers;
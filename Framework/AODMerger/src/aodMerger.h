@@ -10,6 +10,14 @@
 // or submit itself to any jurisdiction.
 
 #include <TString.h>
+#include <TTree.h>
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TBufferFile.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 const char* removeVersionSuffix(const char* treeName)
 {
@@ -48,3 +56,71 @@ const char* getTableName(const char* branchName, const char* treeName)
   // printf("%s --> %s\n", branchName, tableName.Data());
   return tableName;
 }
+
+bool hasVLA(TTree* tree)
+{
+  // variable size arrays are stored with their size column, so that their
+  // values cannot be read one column at a time
+  for (auto obj : *tree->GetListOfBranches()) {
+    if (((TLeaf*)((TBranch*)obj)->GetListOfLeaves()->First())->GetLeafCount() != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+T fromBigEndian(char const* data)
+{
+  static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+  T value;
+  if constexpr (sizeof(T) == 1) {
+    std::memcpy(&value, data, 1);
+  } else if constexpr (sizeof(T) == 2) {
+    uint16_t tmp;
+    std::memcpy(&tmp, data, 2);
+    tmp = __builtin_bswap16(tmp);
+    std::memcpy(&value, &tmp, 2);
+  } else if constexpr (sizeof(T) == 4) {
+    uint32_t tmp;
+    std::memcpy(&tmp, data, 4);
+    tmp = __builtin_bswap32(tmp);
+    std::memcpy(&value, &tmp, 4);
+  } else {
+    uint64_t tmp;
+    std::memcpy(&tmp, data, 8);
+    tmp = __builtin_bswap64(tmp);
+    std::memcpy(&value, &tmp, 8);
+  }
+  return value;
+}
+
+template <typename T>
+std::vector<T> readBranch(TBranch* branch)
+{
+  // read all the entries of a branch holding one value per entry, basket by basket
+  std::vector<T> values(branch->GetEntries());
+  TBufferFile buffer(TBuffer::EMode::kWrite, 4 * 1024 * 1024);
+  Long64_t readEntries = 0;
+  Long64_t entries = values.size();
+  while (readEntries < entries) {
+    auto readLast = branch->GetBulkRead().GetEntriesSerialized(readEntries, buffer);
+    if (readLast <= 0) {
+      // bulk reading not supported for this branch, read the rest entry by entry
+      T value;
+      branch->SetAddress(&value);
+      for (; readEntries < entries; ++readEntries) {
+        branch->GetEntry(readEntries);
+        values[readEntries] = value;
+      }
+      branch->ResetAddress();
+      break;
+    }
+    auto data = buffer.GetCurrent();
+    for (Long64_t i = 0; i < readLast; ++i) {
+      values[readEntries + i] = fromBigEndian<T>(data + i * sizeof(T));
+    }
+    readEntries += readLast;
+  }
+  return values;
+}
@@ -196,68 +196,54 @@ int main(int argc, char* argv[])
     }
 
     // We need to loop over the V0s once and flag the prong indices
-    int trackIdxPos = 0, trackIdxNeg = 0;
     std::unordered_map<int, bool> keepV0TPCs;
-    v0s->SetBranchAddress("fIndexTracks_Pos", &trackIdxPos);
-    v0s->SetBranchAddress("fIndexTracks_Neg", &trackIdxNeg);
-    auto nV0s = v0s->GetEntriesFast();
-    for (int i{0}; i < nV0s; ++i) {
-      v0s->GetEntry(i);
-      keepV0TPCs[trackIdxPos] = true;
-      keepV0TPCs[trackIdxNeg] = true;
+    for (auto trackIdx : readBranch<int>(v0s->GetBranch("fIndexTracks_Pos"))) {
+      keepV0TPCs[trackIdx] = true;
+    }
+    for (auto trackIdx : readBranch<int>(v0s->GetBranch("fIndexTracks_Neg"))) {
+      keepV0TPCs[trackIdx] = true;
     }
 
     std::vector<int> acceptedTracks(trackExtraTree->GetEntries(), -1);
     std::vector<bool> hasCollision(trackExtraTree->GetEntries(), false);
     std::vector<int> keepV0s(v0s->GetEntries(), -1);
 
-    uint8_t tpcNClsFindable = 0;
-    bool bTPClsFindable = false;
-    uint8_t ITSClusterMap = 0;
-    bool bITSClusterMap = false;
-    uint8_t TRDPattern = 0;
-    bool bTRDPattern = false;
-    float_t TOFChi2 = 0;
-    bool bTOFChi2 = false;
-
-    // Test if track properties exist
-    TBranch* br = nullptr;
-    TIter next(trackExtraTree->GetListOfBranches());
-    while ((br = (TBranch*)next())) {
-      TString brName = br->GetName();
-      if (brName == "fTPCNClsFindable") {
-        trackExtraTree->SetBranchAddress("fTPCNClsFindable", &tpcNClsFindable);
-        bTPClsFindable = true;
-      } else if (brName == "fITSClusterMap") {
-        trackExtraTree->SetBranchAddress("fITSClusterMap", &ITSClusterMap);
-        bITSClusterMap = true;
-      } else if (brName == "fTRDPattern") {
-        trackExtraTree->SetBranchAddress("fTRDPattern", &TRDPattern);
-        bTRDPattern = true;
-      } else if (brName == "fTOFChi2") {
-        trackExtraTree->SetBranchAddress("fTOFChi2", &TOFChi2);
-        bTOFChi2 = true;
-      }
+    // Read the track properties which exist, only these columns are needed
+    std::vector<uint8_t> tpcNClsFindable;
+    std::vector<uint8_t> ITSClusterMap;
+    std::vector<uint8_t> TRDPattern;
+    std::vector<float_t> TOFChi2;
+    if (auto br = trackExtraTree->GetBranch("fTPCNClsFindable")) {
+      tpcNClsFindable = readBranch<uint8_t>(br);
+    }
+    if (auto br = trackExtraTree->GetBranch("fITSClusterMap")) {
+      ITSClusterMap = readBranch<uint8_t>(br);
     }
+    if (auto br = trackExtraTree->GetBranch("fTRDPattern")) {
+      TRDPattern = readBranch<uint8_t>(br);
+    }
+    if (auto br = trackExtraTree->GetBranch("fTOFChi2")) {
+      TOFChi2 = readBranch<float_t>(br);
+    }
+    bool bTPClsFindable = !tpcNClsFindable.empty();
+    bool bITSClusterMap = !ITSClusterMap.empty();
+    bool bTRDPattern = !TRDPattern.empty();
+    bool bTOFChi2 = !TOFChi2.empty();
 
-    int fIndexCollisions = 0;
-    track_iu->SetBranchAddress("fIndexCollisions", &fIndexCollisions);
+    auto fIndexCollisions = readBranch<int>(track_iu->GetBranch("fIndexCollisions"));
 
     // loop over all tracks
     auto entries = trackExtraTree->GetEntries();
     int counter = 0;
     for (int i = 0; i < entries; i++) {
-      trackExtraTree->GetEntry(i);
-      track_iu->GetEntry(i);
-
       // Flag collisions
-      hasCollision[i] = (fIndexCollisions >= 0);
+      hasCollision[i] = (fIndexCollisions[i] >= 0);
 
       // Remove TPC only tracks, if (opt.) they are not assoc. to a V0
-      if ((!bTPClsFindable || tpcNClsFindable > 0.) &&
-          (!bITSClusterMap || ITSClusterMap == 0) &&
-          (!bTRDPattern || TRDPattern == 0) &&
-          (!bTOFChi2 || TOFChi2 < -1.) &&
+      if ((!bTPClsFindable || tpcNClsFindable[i] > 0.) &&
+          (!bITSClusterMap || ITSClusterMap[i] == 0) &&
+          (!bTRDPattern || TRDPattern[i] == 0) &&
+          (!bTOFChi2 || TOFChi2[i] < -1.) &&
           (keepV0TPCs.find(i) == keepV0TPCs.end())) {
         counter++;
       } else {
@@ -0,0 +1,69 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test Framework AODMerger
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+#include <TMemFile.h>
+#include <random>
+#include <vector>
+
+#include "../src/aodMerger.h"
+
+namespace
+{
+template <typename T>
+void checkBranch(TTree* tree, const char* name)
+{
+  auto values = readBranch<T>(tree->GetBranch(name));
+  BOOST_REQUIRE_EQUAL(values.size(), static_cast<size_t>(tree->GetEntries()));
+  T value;
+  tree->SetBranchAddress(name, &value);
+  int nMismatches = 0;
+  for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+    tree->GetEntry(i);
+    nMismatches += values[i] != value;
+  }
+  tree->ResetBranchAddresses();
+  BOOST_CHECK_EQUAL(nMismatches, 0);
+}
+} // namespace
+
+// the bulk read of a column must give the same values as reading the tree entry by entry
+BOOST_AUTO_TEST_CASE(TestReadBranch)
+{
+  constexpr Long64_t Entries = 1000;
+  TMemFile file("test_AODMerger.root", "RECREATE");
+  std::mt19937 gen(1);
+  int index = 0;
+  float x = 0;
+  uint8_t flags = 0;
+  auto tree = new TTree("O2track", "O2track");
+  tree->Branch("fIndexCollisions", &index, "fIndexCollisions/I", 512); // small baskets, so that several are read
+  tree->Branch("fX", &x, "fX/F", 512);
+  tree->Branch("fFlags", &flags, "fFlags/b", 512);
+  for (Long64_t i = 0; i < Entries; i++) {
+    index = (gen() % 10 == 0) ? -1 : gen() % 1000;
+    x = gen() / 1000.f;
+    flags = gen() % 256;
+    tree->Fill();
+  }
+  tree->Write();
+  delete tree;
+
+  tree = file.Get<TTree>("O2track");
+  checkBranch<int>(tree, "fIndexCollisions");
+  checkBranch<float>(tree, "fX");
+  checkBranch<uint8_t>(tree, "fFlags");
+  delete tree;
+}
@@ -32,6 +32,7 @@
 #endif
 #include <TGrid.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTreeCache.h>
 #include <TSystem.h>
 
@@ -119,6 +120,21 @@ static inline auto extractOriginalsTuple(framework::pack<Os...>, ProcessingConte
   return std::make_tuple(extractTypedOriginal<Os>(pc)...);
 }
 
+// the columns of a table the tasks bind to, empty if all of them are needed
+static std::vector<std::string> getColumnNames(OutputSpec const& spec)
+{
+  std::vector<std::string> columns;
+  for (auto& m : spec.metadata) {
+    if (m.name == "column:*") {
+      return {};
+    }
+    if (m.name.rfind("column:", 0) == 0) {
+      columns.emplace_back(m.name.substr(7));
+    }
+  }
+  return columns;
+}
+
 AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
 {
   auto callback = AlgorithmSpec{adaptStateful([](ConfigParamRegistry const& options,
@@ -159,6 +175,14 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
+    // with more than one thread, the branches of a DF are decompressed in
+    // parallel and the next DF is loaded while the current one is processed
+    int nThreads = options.get<int>("aod-reader-threads");
+    bool prefetch = nThreads > 1;
+    if (prefetch) {
+      ROOT::EnableImplicitMT(nThreads);
+    }
+
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
@@ -169,6 +193,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
     header::DataHeader TFNumberHeader;
     header::DataHeader TFFileNameHeader;
     std::vector<OutputRoute> requestedTables;
+    std::vector<std::vector<std::string>> requestedColumns;
     std::vector<OutputRoute> routes(spec.outputs);
     for (auto route : routes) {
       if (DataSpecUtils::partialMatch(route.matcher, header::DataOrigin("TFN"))) {
@@ -181,6 +206,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         reportTFFileName = true;
       } else {
         requestedTables.emplace_back(route);
+        requestedColumns.emplace_back(getColumnNames(route.matcher));
       }
     }
 
@@ -189,10 +215,11 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
     return adaptStateless([TFNumberHeader,
                            TFFileNameHeader,
                            requestedTables,
+                           requestedColumns,
                            fileCounter,
                            numTF,
                            watchdog,
-                           didir, reportTFN, reportTFFileName](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
+                           didir, reportTFN, reportTFFileName, prefetch](Monitoring& monitoring, DataAllocator& outputs, ControlService& control, DeviceSpec const& device) {
       // Each parallel reader device.inputTimesliceId reads the files fileCounter*device.maxInputTimeslices+device.inputTimesliceId
       // the TF to read is numTF
       assert(device.inputTimesliceId < device.maxInputTimeslices);
@@ -222,7 +249,8 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         return;
       }
 
-      for (auto& route : requestedTables) {
+      for (size_t ir = 0; ir < requestedTables.size(); ++ir) {
+        auto& route = requestedTables[ir];
         if ((device.inputTimesliceId % route.maxTimeslices) != route.timeslice) {
           continue;
         }
@@ -231,7 +259,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
         auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
         auto dh = header::DataHeader(concrete.description, concrete.origin, concrete.subSpec);
 
-        if (!didir->readTree(outputs, dh, fcnt, ntf, totalSizeCompressed, totalSizeUncompressed)) {
+        if (!didir->readTree(outputs, dh, fcnt, ntf, requestedColumns[ir], totalSizeCompressed, totalSizeUncompressed)) {
           if (first) {
             // check if there is a next file to read
             fcnt += device.maxInputTimeslices;
@@ -245,7 +273,7 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
             }
             // get first folder of next file
             ntf = 0;
-            if (!didir->readTree(outputs, dh, fcnt, ntf, totalSizeCompressed, totalSizeUncompressed)) {
+            if (!didir->readTree(outputs, dh, fcnt, ntf, requestedColumns[ir], totalSizeCompressed, totalSizeUncompressed)) {
               LOGP(fatal, "Can not retrieve tree for table {}: fileCounter {}, timeFrame {}", concrete.origin.as<std::string>(), fcnt, ntf);
               throw std::runtime_error("Processing is stopped!");
             }
@@ -306,6 +334,17 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
           control.readyToQuit(QuitRequest::Me);
           return;
         }
+      } else if (prefetch) {
+        std::vector<std::pair<header::DataHeader, std::vector<std::string>>> tables;
+        for (size_t ir = 0; ir < requestedTables.size(); ++ir) {
+          auto& route = requestedTables[ir];
+          if ((device.inputTimesliceId % route.maxTimeslices) != route.timeslice) {
+            continue;
+          }
+          auto concrete = DataSpecUtils::asConcreteDataMatcher(route.matcher);
+          tables.emplace_back(header::DataHeader(concrete.description, concrete.origin, concrete.subSpec), requestedColumns[ir]);
+        }
+        didir->prefetchTrees(tables, fcnt, ntf);
       }
     });
   })};
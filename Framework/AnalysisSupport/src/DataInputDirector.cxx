@@ -28,6 +28,7 @@
 #include "TMap.h"
 
 #include <uv.h>
+#include <string_view>
 
 #if __has_include(<TJAlienFile.h>)
 #include <TJAlienFile.h>
@@ -35,13 +36,23 @@
 #include <utility>
 #endif
 
-std::vector<std::string> getColumnNames(o2::header::DataHeader dh)
-{
-  auto description = std::string(dh.dataDescription.str);
-  auto origin = std::string(dh.dataOrigin.str);
-
-  // default: column names = {}
-  return {};
+// branches of the tree holding the given columns (including the size branches
+// of the variable size arrays), in the order of the tree
+std::vector<TBranch*> getColumnBranches(TTree* tree, std::vector<std::string> const& columns)
+{
+  static constexpr std::string_view sizeBranchSuffix = "_size";
+  std::vector<TBranch*> branches;
+  for (auto obj : *tree->GetListOfBranches()) {
+    auto branch = static_cast<TBranch*>(obj);
+    std::string_view name = branch->GetName();
+    if (name.ends_with(sizeBranchSuffix)) {
+      name.remove_suffix(sizeBranchSuffix.size());
+    }
+    if (std::find(columns.begin(), columns.end(), name) != columns.end()) {
+      branches.push_back(branch);
+    }
+  }
+  return branches;
 }
 
 namespace o2::framework
@@ -294,6 +305,7 @@ void DataInputDescriptor::printFileStatistics()
 
 void DataInputDescriptor::closeInputFile()
 {
+  clearPrefetchedTrees();
   if (mcurrentFile) {
     if (mParentFile) {
       mParentFile->closeInputFile();
@@ -363,7 +375,7 @@ int DataInputDescriptor::findDFNumber(int file, std::string dfName)
   return it - dfList.begin();
 }
 
-bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
 {
   auto ioStart = uv_hrtime();
 
@@ -373,7 +385,10 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   }
 
   auto fullpath = fileAndFolder.folderName + "/" + treename;
-  auto tree = (TTree*)fileAndFolder.file->Get(fullpath.c_str());
+  auto tree = getPrefetchedTree(fileAndFolder.file, fullpath);
+  if (!tree) {
+    tree = (TTree*)fileAndFolder.file->Get(fullpath.c_str());
+  }
 
   if (!tree) {
     LOGP(debug, "Could not find tree {}. Trying in parent file.", fullpath.c_str());
@@ -384,7 +399,7 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
         throw std::runtime_error(fmt::format(R"(DF {} listed in parent file map but not found in the corresponding file "{}")", fileAndFolder.folderName, parentFile->mcurrentFile->GetName()));
       }
       // first argument is 0 as the parent file object contains only 1 file
-      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, totalSizeCompressed, totalSizeUncompressed);
+      return parentFile->readTree(outputs, dh, 0, parentNumTF, treename, columns, totalSizeCompressed, totalSizeUncompressed);
     }
     throw std::runtime_error(fmt::format(R"(Couldn't get TTree "{}" from "{}". Please check https://aliceo2group.github.io/analysis-framework/docs/troubleshooting/#tree-not-found for more information.)", fileAndFolder.folderName + "/" + treename, fileAndFolder.file->GetName()));
   }
@@ -393,19 +408,22 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   auto o = Output(dh);
   auto t2t = outputs.make<TreeToTable>(o);
 
-  // add branches to read
+  // add branches to read, only the requested columns if any of them is in the tree
   // fill the table
-  auto colnames = getColumnNames(dh);
   t2t->setLabel(tree->GetName());
-  if (colnames.size() == 0) {
+  auto branches = columns.empty() ? std::vector<TBranch*>{} : getColumnBranches(tree, columns);
+  if (branches.empty()) {
     totalSizeCompressed += tree->GetZipBytes();
     totalSizeUncompressed += tree->GetTotBytes();
     t2t->addAllColumns(tree);
   } else {
-    for (auto& colname : colnames) {
-      TBranch* branch = tree->GetBranch(colname.c_str());
+    std::vector<std::string> colnames;
+    for (auto branch : branches) {
       totalSizeCompressed += branch->GetZipBytes("*");
       totalSizeUncompressed += branch->GetTotBytes("*");
+      if (std::find(columns.begin(), columns.end(), branch->GetName()) != columns.end()) {
+        colnames.emplace_back(branch->GetName());
+      }
     }
     t2t->addAllColumns(tree, std::move(colnames));
   }
@@ -417,6 +435,70 @@ bool DataInputDescriptor::readTree(DataAllocator& outputs, header::DataHeader dh
   return true;
 }
 
+void DataInputDescriptor::prefetchTrees(int counter, int numTF, std::vector<std::pair<std::string, std::vector<std::string>>> const& trees)
+{
+  clearPrefetchedTrees();
+
+  // same checks as in getFileFolder, but the DF is not flagged as read yet
+  if (!setFile(counter)) {
+    return;
+  }
+  if (mfilenames[counter]->numberOfTimeFrames > 0 && numTF >= mfilenames[counter]->numberOfTimeFrames) {
+    return;
+  }
+  auto folderName = (mfilenames[counter]->listOfTimeFrameKeys)[numTF];
+
+  mPrefetchedFile = mcurrentFile;
+  mPrefetchResult = std::async(std::launch::async, [this, file = mcurrentFile, folderName, trees]() {
+    for (auto& [treename, columns] : trees) {
+      auto fullpath = folderName + "/" + treename;
+      auto tree = (TTree*)file->Get(fullpath.c_str());
+      if (!tree) {
+        // e.g. in the parent file, read as usual
+        continue;
+      }
+      auto branches = columns.empty() ? std::vector<TBranch*>{} : getColumnBranches(tree, columns);
+      if (branches.empty()) {
+        tree->LoadBaskets();
+      } else {
+        for (auto branch : branches) {
+          branch->LoadBaskets();
+        }
+      }
+      mPrefetchedTrees[fullpath] = tree;
+    }
+  });
+}
+
+TTree* DataInputDescriptor::getPrefetchedTree(TFile* file, std::string const& fullpath)
+{
+  if (mPrefetchResult.valid()) {
+    mPrefetchResult.get();
+  }
+  if (file != mPrefetchedFile) {
+    return nullptr;
+  }
+  auto it = mPrefetchedTrees.find(fullpath);
+  if (it == mPrefetchedTrees.end()) {
+    return nullptr;
+  }
+  auto tree = it->second;
+  mPrefetchedTrees.erase(it);
+  return tree;
+}
+
+void DataInputDescriptor::clearPrefetchedTrees()
+{
+  if (mPrefetchResult.valid()) {
+    mPrefetchResult.get();
+  }
+  for (auto& [fullpath, tree] : mPrefetchedTrees) {
+    delete tree;
+  }
+  mPrefetchedTrees.clear();
+  mPrefetchedFile = nullptr;
+}
+
 DataInputDirector::DataInputDirector()
 {
   createDefaultDataInputDescriptor();
@@ -745,7 +827,7 @@ uint64_t DataInputDirector::getTimeFrameNumber(header::DataHeader dh, int counte
   return didesc->getTimeFrameNumber(counter, numTF);
 }
 
-bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
+bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed)
 {
   std::string treename;
 
@@ -761,7 +843,31 @@ bool DataInputDirector::readTree(DataAllocator& outputs, header::DataHeader dh,
     treename = aod::datamodel::getTreeName(dh);
   }
 
-  return didesc->readTree(outputs, dh, counter, numTF, treename, totalSizeCompressed, totalSizeUncompressed);
+  return didesc->readTree(outputs, dh, counter, numTF, treename, columns, totalSizeCompressed, totalSizeUncompressed);
+}
+
+void DataInputDirector::prefetchTrees(std::vector<std::pair<header::DataHeader, std::vector<std::string>>> const& tables, int counter, int numTF)
+{
+  // group the trees by input descriptor, each of them reads from its own file
+  std::vector<std::pair<DataInputDescriptor*, std::vector<std::pair<std::string, std::vector<std::string>>>>> trees;
+  for (auto& [dh, columns] : tables) {
+    std::string treename;
+    auto didesc = getDataInputDescriptor(dh);
+    if (didesc) {
+      treename = didesc->treename;
+    } else {
+      didesc = mdefaultDataInputDescriptor;
+      treename = aod::datamodel::getTreeName(dh);
+    }
+    auto lookup = std::find_if(trees.begin(), trees.end(), [didesc](auto const& entry) { return entry.first == didesc; });
+    if (lookup == trees.end()) {
+      lookup = trees.emplace(trees.end(), didesc, std::vector<std::pair<std::string, std::vector<std::string>>>{});
+    }
+    lookup->second.emplace_back(treename, columns);
+  }
+  for (auto& [didesc, descTrees] : trees) {
+    didesc->prefetchTrees(counter, numTF, descTrees);
+  }
 }
 
 void DataInputDirector::closeInputFiles()
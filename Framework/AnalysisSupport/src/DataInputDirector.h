@@ -16,9 +16,13 @@
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataAllocator.h"
 
+#include <future>
 #include <regex>
+#include <unordered_map>
 #include "rapidjson/fwd.h"
 
+class TTree;
+
 namespace o2::monitoring
 {
 class Monitoring;
@@ -83,7 +87,11 @@ class DataInputDescriptor
   int getTimeFramesInFile(int counter);
   int getReadTimeFramesInFile(int counter);
 
-  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  // read the given columns of a tree into a table, all the columns if empty
+  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::string treename, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  // load the baskets of the given trees (name, columns) of a DF in the background, used by the following readTree
+  // requires ROOT thread safety to be enabled
+  void prefetchTrees(int counter, int numTF, std::vector<std::pair<std::string, std::vector<std::string>>> const& trees);
 
   void printFileStatistics();
   void closeInputFile();
@@ -112,6 +120,14 @@ class DataInputDescriptor
 
   uint64_t mIOTime = 0;
   uint64_t mCurrentFileStartedAt = 0;
+
+  // trees of the next DF loaded in the background, key is the full path of the tree
+  std::future<void> mPrefetchResult;
+  TFile* mPrefetchedFile = nullptr;
+  std::unordered_map<std::string, TTree*> mPrefetchedTrees;
+
+  TTree* getPrefetchedTree(TFile* file, std::string const& fullpath);
+  void clearPrefetchedTrees();
 };
 
 class DataInputDirector
@@ -141,7 +157,8 @@ class DataInputDirector
   DataInputDescriptor* getDataInputDescriptor(header::DataHeader dh);
   int getNumberInputDescriptors() { return mdataInputDescriptors.size(); }
 
-  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  bool readTree(DataAllocator& outputs, header::DataHeader dh, int counter, int numTF, std::vector<std::string> const& columns, size_t& totalSizeCompressed, size_t& totalSizeUncompressed);
+  void prefetchTrees(std::vector<std::pair<header::DataHeader, std::vector<std::string>>> const& tables, int counter, int numTF);
   uint64_t getTimeFrameNumber(header::DataHeader dh, int counter, int numTF);
   FileAndFolder getFileFolder(header::DataHeader dh, int counter, int numTF);
   int getTimeFramesInFile(header::DataHeader dh, int counter);
@@ -77,6 +77,13 @@ auto createFieldsFromColumns(framework::pack<C...>)
 
 using SelectionVector = std::vector<int64_t>;
 
+/// Union and intersection of sorted selections of the rows of a table with nRows
+/// rows. Dense selections are combined through a temporary bitmap of the table rows,
+/// sparse ones and rows out of [0, nRows) with a sorted merge. Only the combination
+/// is faster, the result is the sorted row index vector Filtered keeps.
+SelectionVector sumSelections(gsl::span<int64_t const> const& lhs, gsl::span<int64_t const> const& rhs, int64_t nRows);
+SelectionVector intersectSelections(gsl::span<int64_t const> const& lhs, gsl::span<int64_t const> const& rhs, int64_t nRows);
+
 template <typename, typename = void>
 inline constexpr bool is_index_column_v = false;
 
@@ -3039,41 +3046,25 @@ class FilteredBase : public T
 
   void sumWithSelection(SelectionVector const& selection)
   {
-    mCached = true;
-    SelectionVector rowsUnion;
-    std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = rowsUnion;
-    resetRanges();
+    sumWithSelection(gsl::span<int64_t const>{selection});
   }
 
   void intersectWithSelection(SelectionVector const& selection)
   {
-    mCached = true;
-    SelectionVector intersection;
-    std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = intersection;
-    resetRanges();
+    intersectWithSelection(gsl::span<int64_t const>{selection});
   }
 
   void sumWithSelection(gsl::span<int64_t const> const& selection)
   {
     mCached = true;
-    SelectionVector rowsUnion;
-    std::set_union(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(rowsUnion));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = rowsUnion;
+    mSelectedRowsCache = sumSelections(mSelectedRows, selection, tableSize());
     resetRanges();
   }
 
   void intersectWithSelection(gsl::span<int64_t const> const& selection)
   {
     mCached = true;
-    SelectionVector intersection;
-    std::set_intersection(mSelectedRows.begin(), mSelectedRows.end(), selection.begin(), selection.end(), std::back_inserter(intersection));
-    mSelectedRowsCache.clear();
-    mSelectedRowsCache = intersection;
+    mSelectedRowsCache = intersectSelections(mSelectedRows, selection, tableSize());
     resetRanges();
   }
 
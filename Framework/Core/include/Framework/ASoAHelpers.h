@@ -17,9 +17,12 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <atomic>
 #include <iterator>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace o2::soa
 {
@@ -1304,6 +1307,60 @@ auto selfCombinations(const BP& binningPolicy, int categoryNeighbours, const T1&
   return CombinationsGenerator<CombinationsBlockStrictlyUpperSameIndexPolicy<BP, T1, T2s...>>(CombinationsBlockStrictlyUpperSameIndexPolicy<BP, T1, T2s...>(binningPolicy, categoryNeighbours, outsider, tables...));
 }
 
+/// Call f(threadId, combination) for all the combinations of a block policy over
+/// the same table (e.g. CombinationsBlockStrictlyUpperSameIndexPolicy), with the
+/// binning categories dispatched to nThreads threads. Combinations never span
+/// several categories, so each thread walks whole categories with its own copy
+/// of the policy. f is called concurrently: it must only fill outputs owned by
+/// threadId (0 <= threadId < nThreads), to be merged once this returns.
+template <typename P, typename F>
+void parallelCombinations(int nThreads, P const& policy, F&& f)
+{
+  if (policy.mIsEnd) {
+    return;
+  }
+  auto const& groupedIndices = policy.mGroupedIndices;
+  std::vector<uint64_t> categoryStarts;
+  for (auto catBegin = groupedIndices.begin(); catBegin != groupedIndices.end();) {
+    categoryStarts.push_back(std::distance(groupedIndices.begin(), catBegin));
+    catBegin = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
+  }
+  categoryStarts.push_back(groupedIndices.size());
+  uint64_t nCategories = categoryStarts.size() - 1;
+
+  // categories are picked up one by one, as their sizes can be very different
+  std::atomic<uint64_t> nextCategory{0};
+  auto worker = [&](int threadId) {
+    P local(policy);
+    for (auto cat = nextCategory++; cat < nCategories; cat = nextCategory++) {
+      local.mGroupedIndices.assign(groupedIndices.begin() + categoryStarts[cat], groupedIndices.begin() + categoryStarts[cat + 1]);
+      std::get<0>(local.mCurrentIndices) = 0;
+      local.mIsEnd = false;
+      local.mIsNewWindow = true;
+      local.setRanges();
+      for (; !local.mIsEnd; local.addOne()) {
+        f(threadId, local.mCurrent);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int threadId = 1; threadId < nThreads; ++threadId) {
+    threads.emplace_back(worker, threadId);
+  }
+  worker(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+template <typename BP, typename T1, typename F, typename... T2s>
+void parallelSelfCombinations(int nThreads, const BP& binningPolicy, int categoryNeighbours, const T1& outsider, F&& f, const T2s&... tables)
+{
+  static_assert(isSameType<T2s...>(), "Tables must have the same type for self combinations");
+  parallelCombinations(nThreads, CombinationsBlockStrictlyUpperSameIndexPolicy<BP, T1, T2s...>(binningPolicy, categoryNeighbours, outsider, tables...), std::forward<F>(f));
+}
+
 template <typename BP, typename T1, typename T2>
 auto selfPairCombinations(const BP& binningPolicy, int categoryNeighbours, const T1& outsider)
 {
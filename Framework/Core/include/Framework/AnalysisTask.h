@@ -121,6 +121,15 @@ struct AnalysisDataProcessorBuilder {
     }(framework::pack<Args...>{});
   }
 
+  /// The persistent columns of a table the task binds to, so that the reader
+  /// only needs to read those. Filters and partitions can only refer to these
+  /// columns, so the columns they use are included as well
+  template <typename... C>
+  static void addColumnsMetadata(framework::pack<C...>, std::vector<ConfigParamSpec>& inputMetadata)
+  {
+    (inputMetadata.emplace_back(ConfigParamSpec{std::string{"column:"} + C::columnLabel(), VariantType::Bool, true, {"\"\""}}), ...);
+  }
+
   template <typename O>
   static void addOriginal(const char* name, bool value, std::vector<InputSpec>& inputs) requires soa::is_type_with_metadata_v<aod::MetadataTrait<std::decay_t<O>>>
   {
@@ -130,6 +139,8 @@ struct AnalysisDataProcessorBuilder {
     if constexpr (soa::is_soa_index_table_v<std::decay_t<O>> || soa::is_soa_extension_table_v<std::decay_t<O>>) {
       auto inputSources = getInputMetadata<std::decay_t<O>>();
       inputMetadata.insert(inputMetadata.end(), inputSources.begin(), inputSources.end());
+    } else {
+      addColumnsMetadata(typename std::decay_t<O>::persistent_columns_t{}, inputMetadata);
     }
     DataSpecUtils::updateInputList(inputs, InputSpec{metadata::tableLabel(), metadata::origin(), metadata::description(), metadata::version(), Lifetime::Timeframe, inputMetadata});
   }
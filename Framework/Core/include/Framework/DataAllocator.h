@@ -407,6 +407,12 @@ class DataAllocator
   void snapshot(const Output& spec, const char* payload, size_t payloadSize,
                 o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
 
+  /// Send the payload held by an existing message, e.g. one of the inputs,
+  /// without copying it. When the transport of the output does not allow to
+  /// share the message, this falls back to a snapshot of the payload.
+  void shallowSnapshot(const Output& spec, fair::mq::Message const& payload,
+                       o2::header::SerializationMethod serializationMethod = o2::header::gSerializationMethodNone);
+
   /// make an object of type T and route to output specified by OutputRef
   /// The object is owned by the framework, returned reference can be used to fill the object.
   ///
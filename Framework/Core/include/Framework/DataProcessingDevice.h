@@ -27,6 +27,7 @@
 #include "Framework/Tracing.h"
 #include "Framework/RunningWorkflowInfo.h"
 #include "Framework/ObjectCache.h"
+#include "Framework/StreamExecutor.h"
 
 #include <fairmq/Device.h>
 #include <fairmq/Parts.h>
@@ -37,7 +38,6 @@
 
 namespace o2::framework
 {
-
 struct InputChannelInfo;
 struct DeviceState;
 struct ComputingQuotaEvaluator;
@@ -119,6 +119,8 @@ class DataProcessingDevice : public fair::mq::Device
   /// Handle to wake up the main loop from other threads
   /// e.g. when FairMQ notifies some callback in an asynchronous way
   uv_async_t* mAwakeHandle = nullptr;
+  /// Dedicated threads for the processing streams, if requested.
+  std::unique_ptr<StreamExecutor> mStreamExecutor;
 };
 
 } // namespace o2::framework
@@ -25,6 +25,7 @@
 
 namespace o2::framework
 {
+struct DeviceMetricsRing;
 
 /// This struct holds information about a given
 /// device as known by the driver. Due to the distributed
@@ -86,6 +87,9 @@ struct DeviceInfo {
   size_t lastSignal;
   /// An incremental number for the state of the device
   int providedState = 0;
+  /// Shared memory ring used by the device to send its numeric
+  /// metrics to the driver, nullptr if not available.
+  DeviceMetricsRing* metricsRing = nullptr;
 };
 
 } // namespace o2::framework
@@ -34,6 +34,13 @@ struct DeviceMetricsHelper {
   /// Helper function to parse a metric string.
   static bool parseMetric(std::string_view const s, ParsedMetricMatch& results);
 
+  /// @return true if the metric called @a name (including its index, if any)
+  /// holds enum values, i.e. it is one of the data_relayer states.
+  static bool isEnumMetric(std::string_view name)
+  {
+    return name.size() > 13 && name.substr(0, 13) == "data_relayer/" && name[13] != 'w' && name[13] != 'h';
+  }
+
   /// Processes a parsed metric and stores in the backend store.
   ///
   /// @matches is the regexp_matches from the metric identifying regex
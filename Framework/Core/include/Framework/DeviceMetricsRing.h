@@ -0,0 +1,153 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_DEVICEMETRICSRING_H_
+#define O2_FRAMEWORK_DEVICEMETRICSRING_H_
+
+#include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsHelper.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace o2::framework
+{
+
+/// A single numeric metric, in binary form.
+struct MetricRecord {
+  static constexpr size_t MAX_NAME_SIZE = 96;
+  /// Sequence number used to synchronise producers and consumer.
+  std::atomic<uint64_t> sequence;
+  /// Milliseconds since epoch, like for the text metrics.
+  size_t timestamp;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value;
+  };
+  MetricType type;
+  unsigned char nameSize;
+  char name[MAX_NAME_SIZE];
+};
+
+/// A bounded, lock free, multiple producers / single consumer ring of
+/// numeric metrics. It is meant to be placed in a shared memory segment
+/// created by the driver, so that devices can push their metrics without
+/// formatting them and the driver can ingest them without parsing.
+/// Metrics which do not fit (strings, long names) should go through the
+/// usual text path. Metrics pushed while the ring is full should rather be
+/// dropped: sending them as text would let them overtake older samples
+/// still in the ring.
+struct DeviceMetricsRing {
+  static constexpr size_t CAPACITY = 4096;
+  static constexpr size_t MAX_SEGMENT_NAME_SIZE = 64;
+  static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+
+  /// Name of the shared memory segment holding the ring.
+  char segmentName[MAX_SEGMENT_NAME_SIZE];
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  MetricRecord records[CAPACITY];
+
+  /// Initialise an empty ring in already allocated memory.
+  static DeviceMetricsRing* init(void* memory, char const* segmentName);
+
+  /// Push a metric in the ring. Can be invoked concurrently by multiple threads.
+  /// @return false if the metric cannot be pushed, either because the ring is
+  /// full or because its name is too long.
+  template <typename T>
+  bool push(std::string_view name, T value, size_t timestamp)
+  {
+    static_assert(std::is_same_v<T, int> || std::is_same_v<T, uint64_t> || std::is_same_v<T, float>, "Unsupported metric type");
+    if (name.size() > MetricRecord::MAX_NAME_SIZE) {
+      return false;
+    }
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    MetricRecord* record;
+    while (true) {
+      record = &records[pos & (CAPACITY - 1)];
+      auto sequence = record->sequence.load(std::memory_order_acquire);
+      auto diff = (int64_t)sequence - (int64_t)pos;
+      if (diff == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+    record->timestamp = timestamp;
+    if constexpr (std::is_same_v<T, int>) {
+      record->type = MetricType::Int;
+      record->intValue = value;
+    } else if constexpr (std::is_same_v<T, float>) {
+      record->type = MetricType::Float;
+      record->floatValue = value;
+    } else {
+      record->type = MetricType::Uint64;
+      record->uint64Value = value;
+    }
+    record->nameSize = name.size();
+    memcpy(record->name, name.data(), name.size());
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Invoke @a callback for all the records available in the ring and
+  /// release them. Must be invoked by a single consumer.
+  /// @return the number of consumed records.
+  template <typename F>
+  size_t consume(F&& callback)
+  {
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (true) {
+      MetricRecord& record = records[pos & (CAPACITY - 1)];
+      if (record.sequence.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+      callback(record);
+      record.sequence.store(pos + CAPACITY, std::memory_order_release);
+      pos++;
+      count++;
+    }
+    tail.store(pos, std::memory_order_relaxed);
+    return count;
+  }
+};
+
+struct DeviceMetricsRingHelper {
+  /// Create a new shared memory segment called @a segmentName with an empty ring inside.
+  /// @return nullptr in case the segment could not be created.
+  static DeviceMetricsRing* create(char const* segmentName);
+  /// Map the ring in the shared memory segment called @a segmentName.
+  /// The name is unlinked as soon as the ring is mapped, so that the
+  /// segment goes away once both the driver and the device are gone.
+  /// @return nullptr in case the segment could not be mapped.
+  static DeviceMetricsRing* attach(char const* segmentName);
+  /// Unmap the ring and remove its segment, if still there.
+  static void release(DeviceMetricsRing* ring);
+
+  /// Ingest all the pending records of @a ring into @a info, exactly like
+  /// DeviceMetricsHelper::processMetric would do for the corresponding text metric.
+  /// @return the number of processed metrics.
+  static size_t drain(DeviceMetricsRing& ring,
+                      DeviceMetricsInfo& info,
+                      DeviceMetricsHelper::NewMetricCallback newMetricCallback = nullptr);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEMETRICSRING_H_
@@ -211,7 +211,7 @@ struct GroupSlicer {
             } else {
               if (!selection.empty()) {
                 if constexpr (std::decay_t<A1>::applyFilters) {
-                  std::set_intersection(selection.begin(), selection.end(), selections[index]->begin(), selections[index]->end(), std::back_inserter(s));
+                  s = soa::intersectSelections(selection, *selections[index], originalTable.asArrowTable()->num_rows());
                 } else {
                   std::copy(selection.begin(), selection.end(), std::back_inserter(s));
                 }
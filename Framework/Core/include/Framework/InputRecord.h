@@ -196,6 +196,11 @@ class InputRecord
 
   [[nodiscard]] size_t getNofParts(int pos) const;
 
+  /// @return the message holding the payload of the input at @a pos, nullptr
+  /// if the inputs are not backed by messages. Meant to be used to send the
+  /// payload again without copying it, see DataAllocator::shallowSnapshot.
+  [[nodiscard]] fair::mq::Message* getPayloadMessageByPos(int pos, int part = 0) const;
+
   // Given a binding by string, return the associated DataRef
   DataRef getDataRefByString(const char* bindingName, int part = 0) const
   {
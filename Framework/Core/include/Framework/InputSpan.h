@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_INPUTSPAN_H_
 
 #include "Framework/DataRef.h"
+#include <fairmq/FwdDecls.h>
 #include <functional>
 
 extern template class std::function<o2::framework::DataRef(size_t)>;
@@ -54,6 +55,21 @@ class InputSpan
     return mGetter(i, partidx);
   }
 
+  /// @a getter is the mapping between an element of the span and the
+  /// message holding its payload, for those stores which are backed by
+  /// actual messages. Allows sending the payload again without copying it.
+  void setPayloadMessageGetter(std::function<fair::mq::Message*(size_t, size_t)> getter)
+  {
+    mPayloadMessageGetter = std::move(getter);
+  }
+
+  /// The message holding the payload of the @a i-th element of the InputSpan,
+  /// nullptr if not available.
+  [[nodiscard]] fair::mq::Message* payloadMessage(size_t i, size_t partidx = 0) const
+  {
+    return mPayloadMessageGetter ? mPayloadMessageGetter(i, partidx) : nullptr;
+  }
+
   /// @a number of parts in the i-th element of the InputSpan
   [[nodiscard]] size_t getNofParts(size_t i) const
   {
@@ -236,6 +252,7 @@ class InputSpan
  private:
   std::function<DataRef(size_t, size_t)> mGetter;
   std::function<size_t(size_t)> mNofPartsGetter;
+  std::function<fair::mq::Message*(size_t, size_t)> mPayloadMessageGetter;
   size_t mSize;
 };
 
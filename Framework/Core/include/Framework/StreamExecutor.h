@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef O2_FRAMEWORK_STREAMEXECUTOR_H_
+#define O2_FRAMEWORK_STREAMEXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+typedef struct uv_loop_s uv_loop_t;
+typedef struct uv_async_s uv_async_t;
+
+namespace o2::framework
+{
+
+/// A dedicated pool of threads executing the work of the DPL processing
+/// streams, as an alternative to the libuv thread pool, which is shared with
+/// any other uv work and whose size is only controlled by UV_THREADPOOL_SIZE.
+///
+/// Every stream has its own queue, which is always served by the same
+/// thread, so that the work for a given stream is executed in order.
+/// Threads can optionally be pinned to a set of CPUs.
+/// Completion callbacks are executed by the thread running the loop
+/// provided at construction time, like for uv_queue_work.
+class StreamExecutor
+{
+ public:
+  /// @a cpus is the list of cpus to pin the threads to, thread i being
+  /// pinned to cpus[i % cpus.size()]. Empty means no pinning.
+  StreamExecutor(uv_loop_t* loop, int nThreads, std::vector<int> const& cpus = {});
+  ~StreamExecutor();
+
+  /// Schedule @a work for stream @a streamId. Once done, @a completion
+  /// will be invoked by the thread running the loop.
+  void submit(int streamId, std::function<void()> work, std::function<void()> completion);
+  /// Wait for all the scheduled work to be done, stop the threads
+  /// and invoke the pending completions from the calling thread.
+  void shutdown();
+
+  [[nodiscard]] int threads() const { return mWorkers.size(); }
+
+  /// Parse a list of cpus in the "0-3,8,10-11" format.
+  static std::vector<int> parseCPUList(std::string_view list);
+  /// @return the cpus belonging to the NUMA node @a node, empty if they cannot be found.
+  static std::vector<int> cpusForNUMANode(int node);
+
+ private:
+  struct Task {
+    std::function<void()> work;
+    std::function<void()> completion;
+  };
+
+  struct Worker {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// One queue per stream served by this worker.
+    std::vector<std::deque<Task>> queues;
+    /// Next queue to look at, so that streams are served round robin.
+    size_t next = 0;
+    bool stop = false;
+  };
+
+  void workerLoop(Worker& worker, int cpu);
+  void runCompletions();
+
+  std::vector<std::unique_ptr<Worker>> mWorkers;
+  std::mutex mCompletedMutex;
+  std::vector<std::function<void()>> mCompleted;
+  uv_async_t* mAsync = nullptr;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_STREAMEXECUTOR_H_
@@ -43,6 +43,9 @@ namespace o2::framework
 //    t2t.addAllColumns();
 //  . auto ta = t2t.process();
 //
+// If ROOT implicit multi-threading is enabled, the branches are decompressed
+// in parallel.
+//
 // .............................................................................
 struct ROOTTypeInfo {
   EDataType type;
@@ -72,6 +75,7 @@ class BranchToColumn
   arrow::ArrayBuilder* mValueBuilder = nullptr;
   std::unique_ptr<arrow::ArrayBuilder> mListBuilder = nullptr;
   int mListSize = 1;
+  int mTypeSize = 0;
   std::unique_ptr<arrow::ArrayBuilder> mBuilder = nullptr;
   arrow::MemoryPool* mPool = nullptr;
 };
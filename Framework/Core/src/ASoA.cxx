@@ -14,6 +14,8 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/util/key_value_metadata.h>
 #include <arrow/util/config.h>
+#include <algorithm>
+#include <bit>
 
 namespace o2::soa
 {
@@ -32,6 +34,11 @@ void missingFilterDeclaration(int hash, int ai)
 
 SelectionVector selectionToVector(gandiva::Selection const& sel)
 {
+  if (sel->GetMode() == gandiva::SelectionVector::MODE_UINT64) {
+    // rows are stored contiguously as unsigned 64 bit integers, copy them at once
+    auto array = std::static_pointer_cast<arrow::UInt64Array>(sel->ToArray());
+    return SelectionVector(array->raw_values(), array->raw_values() + array->length());
+  }
   SelectionVector rows;
   rows.resize(sel->GetNumSlots());
   for (auto i = 0; i < sel->GetNumSlots(); ++i) {
@@ -40,6 +47,89 @@ SelectionVector selectionToVector(gandiva::Selection const& sel)
   return rows;
 }
 
+namespace
+{
+using SelectionBitmap = std::vector<uint64_t>;
+
+// a bitmap pays off once the selections have more than a few rows per bitmap word
+bool useBitmap(size_t nSelected, int64_t nRows)
+{
+  return nRows > 0 && static_cast<int64_t>(nSelected) * 16 >= nRows;
+}
+
+// the selections are sorted, rows outside of [0, nRows) cannot be set in the bitmap
+bool inRange(gsl::span<int64_t const> const& rows, int64_t nRows)
+{
+  return rows.empty() || (rows.front() >= 0 && rows.back() < nRows);
+}
+
+SelectionBitmap toBitmap(gsl::span<int64_t const> const& rows, int64_t nRows)
+{
+  SelectionBitmap bitmap((nRows + 63) / 64, 0);
+  for (auto row : rows) {
+    bitmap[row >> 6] |= uint64_t{1} << (row & 63);
+  }
+  return bitmap;
+}
+
+bool isSet(SelectionBitmap const& bitmap, int64_t row)
+{
+  return (bitmap[row >> 6] >> (row & 63)) & 1;
+}
+} // namespace
+
+SelectionVector sumSelections(gsl::span<int64_t const> const& lhs, gsl::span<int64_t const> const& rhs, int64_t nRows)
+{
+  SelectionVector rows;
+  if (!useBitmap(lhs.size() + rhs.size(), nRows) || !inRange(lhs, nRows) || !inRange(rhs, nRows)) {
+    rows.reserve(lhs.size() + rhs.size());
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(rows));
+    return rows;
+  }
+  auto bitmap = toBitmap(lhs, nRows);
+  for (auto row : rhs) {
+    bitmap[row >> 6] |= uint64_t{1} << (row & 63);
+  }
+  rows.reserve(lhs.size() + rhs.size());
+  for (size_t iw = 0; iw < bitmap.size(); ++iw) {
+    for (auto word = bitmap[iw]; word != 0; word &= word - 1) {
+      rows.push_back(static_cast<int64_t>(iw * 64 + std::countr_zero(word)));
+    }
+  }
+  return rows;
+}
+
+SelectionVector intersectSelections(gsl::span<int64_t const> const& lhs, gsl::span<int64_t const> const& rhs, int64_t nRows)
+{
+  SelectionVector rows;
+  auto const& small = lhs.size() <= rhs.size() ? lhs : rhs;
+  auto const& large = lhs.size() <= rhs.size() ? rhs : lhs;
+  rows.reserve(small.size());
+  if (small.size() * 16 < large.size()) {
+    // look the few rows up in the large selection
+    auto start = large.begin();
+    for (auto row : small) {
+      start = std::lower_bound(start, large.end(), row);
+      if (start == large.end()) {
+        break;
+      }
+      if (*start == row) {
+        rows.push_back(row);
+      }
+    }
+  } else if (useBitmap(lhs.size() + rhs.size(), nRows) && inRange(lhs, nRows) && inRange(rhs, nRows)) {
+    auto bitmap = toBitmap(large, nRows);
+    for (auto row : small) {
+      if (isSet(bitmap, row)) {
+        rows.push_back(row);
+      }
+    }
+  } else {
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(rows));
+  }
+  return rows;
+}
+
 std::shared_ptr<arrow::Table> ArrowHelpers::joinTables(std::vector<std::shared_ptr<arrow::Table>>&& tables)
 {
   if (tables.size() == 1) {
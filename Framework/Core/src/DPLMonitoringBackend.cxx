@@ -13,7 +13,9 @@
 #include "Framework/DriverClient.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RuntimeError.h"
+#include "Framework/DeviceMetricsRing.h"
 #include <fmt/format.h>
+#include <cstdlib>
 #include <sstream>
 
 namespace o2::framework
@@ -30,6 +32,11 @@ overloaded(Ts...) -> overloaded<Ts...>;
 DPLMonitoringBackend::DPLMonitoringBackend(ServiceRegistryRef registry)
   : mRegistry{registry}
 {
+  // The driver provides a shared memory ring to send numeric metrics in binary form.
+  char const* ringName = getenv("DPL_METRICS_RING");
+  if (ringName != nullptr && ringName[0] != '\0') {
+    mRing = DeviceMetricsRingHelper::attach(ringName);
+  }
 }
 
 void DPLMonitoringBackend::addGlobalTag(std::string_view name, std::string_view value)
@@ -54,6 +61,34 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
 {
+  // Single valued numeric metrics go through the shared memory ring, if available.
+  // Strings and names which do not fit there use the text protocol. Numeric metrics
+  // pushed while the ring is full are dropped and counted rather than sent as text,
+  // which the driver could process before the older samples still in the ring.
+  if (mRing && metric.getValuesSize() == 1 && metric.getName().size() <= MetricRecord::MAX_NAME_SIZE &&
+      !std::holds_alternative<std::string>(metric.getValues().front().second)) {
+    auto const& name = metric.getName();
+    auto timestamp = convertTimestamp(metric.getTimestamp());
+    bool pushed = std::visit(overloaded{
+                               [&](int value) -> bool { return mRing->push<int>(name, value, timestamp); },
+                               [&](double value) -> bool { return mRing->push<float>(name, (float)value, timestamp); },
+                               [&](uint64_t value) -> bool { return mRing->push<uint64_t>(name, value, timestamp); },
+                               [](auto) -> bool { return false; }},
+                             metric.getValues().front().second);
+    if (!pushed) {
+      mDroppedMetrics++;
+      return;
+    }
+    // Report the drops through the ring itself, so that the counter is ordered with the other metrics.
+    auto dropped = mDroppedMetrics.load();
+    auto reported = mReportedDroppedMetrics.load();
+    if (dropped != reported && mReportedDroppedMetrics.compare_exchange_strong(reported, dropped)) {
+      if (!mRing->push<uint64_t>("dpl/metrics_ring_dropped", dropped, timestamp)) {
+        mReportedDroppedMetrics = reported;
+      }
+    }
+    return;
+  }
   std::array<char, 4096> buffer;
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
   for (auto& value : metric.getValues()) {
@@ -13,12 +13,15 @@
 
 #include "Framework/ServiceRegistryRef.h"
 #include "Monitoring/Backend.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 namespace o2::framework
 {
 
 struct ServiceRegistry;
+struct DeviceMetricsRing;
 
 /// \brief Prints metrics to standard output via std::cout
 class DPLMonitoringBackend final : public o2::monitoring::Backend
@@ -47,6 +50,9 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistryRef mRegistry;
+  DeviceMetricsRing* mRing = nullptr; ///< Shared memory ring to the driver, if any
+  std::atomic<uint64_t> mDroppedMetrics = 0;         ///< Metrics dropped because the ring was full
+  std::atomic<uint64_t> mReportedDroppedMetrics = 0; ///< Dropped metrics already reported to the driver
 };
 
 } // namespace o2::framework
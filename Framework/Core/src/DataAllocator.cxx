@@ -304,6 +304,26 @@ void DataAllocator::snapshot(const Output& spec, const char* payload, size_t pay
   addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
 }
 
+void DataAllocator::shallowSnapshot(const Output& spec, fair::mq::Message const& payload,
+                                    o2::header::SerializationMethod serializationMethod)
+{
+  auto& proxy = mRegistry.get<FairMQDeviceProxy>();
+  auto& timingInfo = mRegistry.get<TimingInfo>();
+
+  RouteIndex routeIndex = matchDataHeader(spec, timingInfo.timeslice);
+  auto* transport = proxy.getOutputTransport(routeIndex);
+  if (transport->GetType() != payload.GetType()) {
+    // Messages can only be shared within the same transport.
+    snapshot(spec, static_cast<char const*>(payload.GetData()), payload.GetSize(), serializationMethod);
+    return;
+  }
+  // Copy only increases the reference count of the underlying buffer.
+  fair::mq::MessagePtr payloadMessage(proxy.createOutputMessage(routeIndex, 0));
+  payloadMessage->Copy(payload);
+
+  addPartToContext(routeIndex, std::move(payloadMessage), spec, serializationMethod);
+}
+
 Output DataAllocator::getOutputByBind(OutputRef&& ref)
 {
   if (ref.label.empty()) {
@@ -70,6 +70,7 @@
 #include <TClonesArray.h>
 
 #include <fmt/ostream.h>
+#include <fmt/ranges.h>
 #include <algorithm>
 #include <vector>
 #include <numeric>
@@ -996,6 +997,31 @@ void DataProcessingDevice::InitTask()
   deviceContext.expectedRegionCallbacks = std::stoi(fConfig->GetValue<std::string>("expected-region-callbacks"));
   deviceContext.exitTransitionTimeout = std::stoi(fConfig->GetValue<std::string>("exit-transition-timeout"));
 
+  // Optionally use a dedicated, possibly pinned, set of threads
+  // for the processing streams rather than the libuv thread pool.
+  // Experimental: like the libuv thread pool, it requires the processing
+  // to be safe to run concurrently with the device loop, so it is only
+  // available when building with DPL_ENABLE_THREADING.
+  auto streamThreads = std::stoi(fConfig->GetValue<std::string>("dpl-stream-threads"));
+#ifndef DPL_ENABLE_THREADING
+  if (streamThreads > 0) {
+    LOGP(warning, "Ignoring --dpl-stream-threads {}: DPL was built without DPL_ENABLE_THREADING, processing happens synchronously in the device loop.", streamThreads);
+  }
+#else
+  if (streamThreads > 0 && !mStreamExecutor) {
+    auto cpus = StreamExecutor::parseCPUList(fConfig->GetValue<std::string>("dpl-stream-cpus"));
+    auto numaNode = std::stoi(fConfig->GetValue<std::string>("dpl-stream-numa-node"));
+    if (cpus.empty() && numaNode >= 0) {
+      cpus = StreamExecutor::cpusForNUMANode(numaNode);
+      if (cpus.empty()) {
+        LOGP(warning, "Unable to find the cpus of NUMA node {}. Stream threads will not be pinned.", numaNode);
+      }
+    }
+    LOGP(info, "Using {} dedicated stream threads{}", streamThreads, cpus.empty() ? "" : fmt::format(" pinned to cpus {}", fmt::join(cpus, ",")));
+    mStreamExecutor = std::make_unique<StreamExecutor>(state.loop, streamThreads, cpus);
+  }
+#endif
+
   for (auto& channel : GetChannels()) {
     channel.second.at(0).Transport()->SubscribeToRegionEvents([&context = deviceContext,
                                                                &registry = mServiceRegistry,
@@ -1449,8 +1475,14 @@ void DataProcessingDevice::Run()
         stream.running = true;
         stream.registry = &mServiceRegistry;
 #ifdef DPL_ENABLE_THREADING
-        stream.task.data = &handle;
-        uv_queue_work(state.loop, &stream.task, run_callback, run_completion);
+        if (mStreamExecutor) {
+          uv_work_t* streamHandle = &handle;
+          mStreamExecutor->submit(
+            streamRef.index, [streamHandle]() { run_callback(streamHandle); }, [streamHandle]() { run_completion(streamHandle, 0); });
+        } else {
+          stream.task.data = &handle;
+          uv_queue_work(state.loop, &stream.task, run_callback, run_completion);
+        }
 #else
         run_callback(&handle);
         run_completion(&handle, 0);
@@ -1749,6 +1781,9 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
 void DataProcessingDevice::ResetTask()
 {
   ServiceRegistryRef ref{mServiceRegistry};
+  // Wait for the streams still in flight, so that their completion
+  // is executed before we clear everything.
+  mStreamExecutor.reset();
   ref.get<DataRelayer>().clear();
   auto& deviceContext = ref.get<DeviceContext>();
   // If the signal handler is there, we should
@@ -2153,7 +2188,15 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto nofPartsGetter = [&currentSetOfInputs](size_t i) -> size_t {
       return currentSetOfInputs[i].getNumberOfPairs();
     };
-    return InputSpan{getter, nofPartsGetter, currentSetOfInputs.size()};
+    auto payloadMessageGetter = [&currentSetOfInputs](size_t i, size_t partindex) -> fair::mq::Message* {
+      if (currentSetOfInputs[i].getNumberOfPairs() > partindex) {
+        return currentSetOfInputs[i].associatedPayload(partindex).get();
+      }
+      return nullptr;
+    };
+    InputSpan span{getter, nofPartsGetter, currentSetOfInputs.size()};
+    span.setPayloadMessageGetter(payloadMessageGetter);
+    return span;
   };
 
   auto markInputsAsDone = [ref](TimesliceSlot slot) -> void {
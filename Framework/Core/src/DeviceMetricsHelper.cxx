@@ -138,7 +138,7 @@ bool DeviceMetricsHelper::parseMetric(std::string_view const s, ParsedMetricMatc
           } else {
             break;
           }
-          if (strncmp(match.beginKey, "data_relayer/", 13) == 0 && match.beginKey[13] != 'w' && match.beginKey[13] != 'h') {
+          if (isEnumMetric({match.beginKey, size_t(s.data() + s.size() - match.beginKey)})) {
             match.type = MetricType::Enum;
           }
         }
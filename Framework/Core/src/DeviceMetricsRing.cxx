@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/DeviceMetricsRing.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <new>
+
+namespace o2::framework
+{
+
+DeviceMetricsRing* DeviceMetricsRing::init(void* memory, char const* segmentName)
+{
+  auto* ring = new (memory) DeviceMetricsRing;
+  strncpy(ring->segmentName, segmentName, MAX_SEGMENT_NAME_SIZE - 1);
+  ring->segmentName[MAX_SEGMENT_NAME_SIZE - 1] = '\0';
+  ring->head.store(0, std::memory_order_relaxed);
+  ring->tail.store(0, std::memory_order_relaxed);
+  for (size_t i = 0; i < CAPACITY; ++i) {
+    ring->records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  return ring;
+}
+
+DeviceMetricsRing* DeviceMetricsRingHelper::create(char const* segmentName)
+{
+  int fd = shm_open(segmentName, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  if (ftruncate(fd, sizeof(DeviceMetricsRing)) != 0) {
+    close(fd);
+    shm_unlink(segmentName);
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, sizeof(DeviceMetricsRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(segmentName);
+    return nullptr;
+  }
+  return DeviceMetricsRing::init(memory, segmentName);
+}
+
+DeviceMetricsRing* DeviceMetricsRingHelper::attach(char const* segmentName)
+{
+  int fd = shm_open(segmentName, O_RDWR, 0600);
+  if (fd < 0) {
+    return nullptr;
+  }
+  void* memory = mmap(nullptr, sizeof(DeviceMetricsRing), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  // Nobody else needs to find the segment by name, the driver already has it mapped.
+  shm_unlink(segmentName);
+  if (memory == MAP_FAILED) {
+    return nullptr;
+  }
+  return reinterpret_cast<DeviceMetricsRing*>(memory);
+}
+
+void DeviceMetricsRingHelper::release(DeviceMetricsRing* ring)
+{
+  if (ring == nullptr) {
+    return;
+  }
+  // In case the device never attached to it.
+  shm_unlink(ring->segmentName);
+  munmap(ring, sizeof(DeviceMetricsRing));
+}
+
+size_t DeviceMetricsRingHelper::drain(DeviceMetricsRing& ring,
+                                      DeviceMetricsInfo& info,
+                                      DeviceMetricsHelper::NewMetricCallback newMetricCallback)
+{
+  ParsedMetricMatch match;
+  return ring.consume([&match, &info, &newMetricCallback](MetricRecord const& record) {
+    match.beginKey = record.name;
+    match.endKey = record.name + record.nameSize;
+    match.timestamp = record.timestamp;
+    match.type = record.type;
+    switch (record.type) {
+      case MetricType::Int:
+        match.intValue = record.intValue;
+        match.uint64Value = record.intValue;
+        match.floatValue = record.intValue;
+        break;
+      case MetricType::Float:
+        match.floatValue = record.floatValue;
+        match.intValue = record.floatValue;
+        match.uint64Value = record.floatValue;
+        break;
+      case MetricType::Uint64:
+        match.uint64Value = record.uint64Value;
+        match.intValue = record.uint64Value;
+        match.floatValue = record.uint64Value;
+        break;
+      default:
+        return;
+    }
+    if (DeviceMetricsHelper::isEnumMetric({record.name, record.nameSize})) {
+      match.type = MetricType::Enum;
+    }
+    DeviceMetricsHelper::processMetric(match, info, newMetricCallback);
+  });
+}
+
+} // namespace o2::framework
@@ -1516,6 +1516,9 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("rate", bpo::value<std::string>());
         realOdesc.add_options()("exit-transition-timeout", bpo::value<std::string>());
         realOdesc.add_options()("expected-region-callbacks", bpo::value<std::string>());
+        realOdesc.add_options()("dpl-stream-threads", bpo::value<std::string>());
+        realOdesc.add_options()("dpl-stream-cpus", bpo::value<std::string>());
+        realOdesc.add_options()("dpl-stream-numa-node", bpo::value<std::string>());
         realOdesc.add_options()("timeframes-rate-limit", bpo::value<std::string>());
         realOdesc.add_options()("environment", bpo::value<std::string>());
         realOdesc.add_options()("stacktrace-on-signal", bpo::value<std::string>());
@@ -1702,6 +1705,9 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("rate", bpo::value<std::string>(), "rate for a data source device (Hz)")                                                                                        //
     ("exit-transition-timeout", bpo::value<std::string>(), "timeout before switching to READY state")                                                                //
     ("expected-region-callbacks", bpo::value<std::string>(), "region callbacks to expect before starting")                                                           //
+    ("dpl-stream-threads", bpo::value<std::string>(), "number of dedicated threads for the processing streams")                                                   //
+    ("dpl-stream-cpus", bpo::value<std::string>(), "cpus to pin the stream threads to, e.g. 0-3,8")                                                                  //
+    ("dpl-stream-numa-node", bpo::value<std::string>(), "NUMA node to pin the stream threads to")                                                                   //
     ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframes can be in fly")                                                    //
     ("shm-monitor", bpo::value<std::string>(), "whether to use the shared memory monitor")                                                                           //
     ("channel-prefix", bpo::value<std::string>()->default_value(""), "prefix to use for multiplexing multiple workflows in the same session")                        //
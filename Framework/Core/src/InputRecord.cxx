@@ -134,6 +134,15 @@ size_t InputRecord::getNofParts(int pos) const
   }
   return mSpan.getNofParts(pos);
 }
+
+fair::mq::Message* InputRecord::getPayloadMessageByPos(int pos, int part) const
+{
+  if (pos < 0 || pos >= mSpan.size()) {
+    return nullptr;
+  }
+  return mSpan.payloadMessage(pos, part);
+}
+
 size_t InputRecord::size() const
 {
   return mSpan.size();
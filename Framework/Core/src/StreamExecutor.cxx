@@ -0,0 +1,191 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/StreamExecutor.h"
+#include "Framework/Logger.h"
+#include "Framework/RuntimeError.h"
+#include <uv.h>
+#include <cctype>
+#include <fstream>
+#include <string>
+#include <fmt/format.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace o2::framework
+{
+
+StreamExecutor::StreamExecutor(uv_loop_t* loop, int nThreads, std::vector<int> const& cpus)
+{
+  if (nThreads <= 0) {
+    throw runtime_error_f("Invalid number of stream executor threads: %d", nThreads);
+  }
+  mAsync = (uv_async_t*)malloc(sizeof(uv_async_t));
+  mAsync->data = this;
+  uv_async_init(loop, mAsync, [](uv_async_t* handle) {
+    auto* executor = (StreamExecutor*)handle->data;
+    if (executor) {
+      executor->runCompletions();
+    }
+  });
+  for (int i = 0; i < nThreads; ++i) {
+    mWorkers.emplace_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < nThreads; ++i) {
+    int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+    mWorkers[i]->thread = std::thread([this, &worker = *mWorkers[i], cpu]() { workerLoop(worker, cpu); });
+  }
+}
+
+StreamExecutor::~StreamExecutor()
+{
+  shutdown();
+  if (mAsync) {
+    mAsync->data = nullptr;
+    uv_close((uv_handle_t*)mAsync, [](uv_handle_t* handle) { free(handle); });
+    mAsync = nullptr;
+  }
+}
+
+void StreamExecutor::submit(int streamId, std::function<void()> work, std::function<void()> completion)
+{
+  auto& worker = *mWorkers[streamId % mWorkers.size()];
+  size_t queueIdx = streamId / mWorkers.size();
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.queues.size() <= queueIdx) {
+      worker.queues.resize(queueIdx + 1);
+    }
+    worker.queues[queueIdx].push_back(Task{std::move(work), std::move(completion)});
+  }
+  worker.cv.notify_one();
+}
+
+void StreamExecutor::shutdown()
+{
+  for (auto& worker : mWorkers) {
+    {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      worker->stop = true;
+    }
+    worker->cv.notify_one();
+  }
+  for (auto& worker : mWorkers) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+  runCompletions();
+}
+
+void StreamExecutor::workerLoop(Worker& worker, int cpu)
+{
+#if defined(__linux__)
+  if (cpu >= 0) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+      LOGP(warning, "Unable to pin stream executor thread to cpu {}", cpu);
+    }
+  }
+#endif
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(worker.mutex);
+      auto pending = [&worker]() {
+        for (auto& queue : worker.queues) {
+          if (!queue.empty()) {
+            return true;
+          }
+        }
+        return false;
+      };
+      worker.cv.wait(lock, [&worker, &pending]() { return worker.stop || pending(); });
+      // Drain what is still there before stopping.
+      if (!pending()) {
+        return;
+      }
+      for (size_t i = 0; i < worker.queues.size(); ++i) {
+        auto& queue = worker.queues[(worker.next + i) % worker.queues.size()];
+        if (!queue.empty()) {
+          task = std::move(queue.front());
+          queue.pop_front();
+          worker.next = (worker.next + i + 1) % worker.queues.size();
+          break;
+        }
+      }
+    }
+    task.work();
+    if (task.completion) {
+      std::lock_guard<std::mutex> lock(mCompletedMutex);
+      mCompleted.emplace_back(std::move(task.completion));
+    }
+    uv_async_send(mAsync);
+  }
+}
+
+void StreamExecutor::runCompletions()
+{
+  std::vector<std::function<void()>> completed;
+  {
+    std::lock_guard<std::mutex> lock(mCompletedMutex);
+    completed.swap(mCompleted);
+  }
+  for (auto& completion : completed) {
+    completion();
+  }
+}
+
+std::vector<int> StreamExecutor::parseCPUList(std::string_view list)
+{
+  std::vector<int> cpus;
+  while (!list.empty()) {
+    auto comma = list.find(',');
+    auto token = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    while (!token.empty() && isspace(token.front())) {
+      token.remove_prefix(1);
+    }
+    while (!token.empty() && isspace(token.back())) {
+      token.remove_suffix(1);
+    }
+    if (token.empty()) {
+      continue;
+    }
+    auto dash = token.find('-');
+    try {
+      int first = std::stoi(std::string(token.substr(0, dash)));
+      int last = dash == std::string_view::npos ? first : std::stoi(std::string(token.substr(dash + 1)));
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (std::exception const&) {
+      throw runtime_error_f("Invalid cpu list entry: %.*s", (int)token.size(), token.data());
+    }
+  }
+  return cpus;
+}
+
+std::vector<int> StreamExecutor::cpusForNUMANode(int node)
+{
+  std::ifstream in(fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+  std::string list;
+  if (!in.good() || !std::getline(in, list)) {
+    return {};
+  }
+  return parseCPUList(list);
+}
+
+} // namespace o2::framework
@@ -15,7 +15,11 @@
 #include "arrow/type_traits.h"
 #include <arrow/util/key_value_metadata.h>
 #include <TBufferFile.h>
+#include <TROOT.h>
+#include <ROOT/TSeq.hxx>
+#include <ROOT/TThreadExecutor.hxx>
 
+#include <tuple>
 #include <utility>
 namespace TableTreeHelpers
 {
@@ -107,6 +111,7 @@ BranchToColumn::BranchToColumn(TBranch* branch, bool VLA, std::string name, EDat
     mType{type},
     mArrowType{arrowTypeFromROOT(type, listSize)},
     mListSize{listSize},
+    mTypeSize{TDataType::GetDataType(type)->Size()},
     mPool{pool}
 
 {
@@ -224,7 +229,6 @@ std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> B
       throw runtime_error("Invalid buffer");
     }
 
-    auto typeSize = TDataType::GetDataType(mType)->Size();
     std::unique_ptr<TBufferFile> offsetBuffer = nullptr;
 
     uint32_t offset = 0;
@@ -268,8 +272,8 @@ std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> B
         size = readLast * mListSize;
       }
       readEntries += readLast;
-      swapCopy(ptr, buffer->GetCurrent(), size, typeSize);
-      ptr += (ptrdiff_t)(size * typeSize);
+      swapCopy(ptr, buffer->GetCurrent(), size, mTypeSize);
+      ptr += (ptrdiff_t)(size * mTypeSize);
     }
     if (!mVLA) {
       totalSize = readEntries * mListSize;
@@ -550,14 +554,22 @@ void TreeToTable::setLabel(const char* label)
 
 void TreeToTable::fill(TTree*)
 {
-  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
-  std::vector<std::shared_ptr<arrow::Field>> fields;
-  static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
-  for (auto& reader : mBranchReaders) {
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> columns(mBranchReaders.size());
+  std::vector<std::shared_ptr<arrow::Field>> fields(mBranchReaders.size());
+  auto readColumn = [&](unsigned int i) {
+    thread_local TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
     buffer.Reset();
-    auto arrayAndField = reader->read(&buffer);
-    columns.push_back(arrayAndField.first);
-    fields.push_back(arrayAndField.second);
+    std::tie(columns[i], fields[i]) = mBranchReaders[i]->read(&buffer);
+  };
+  if (ROOT::IsImplicitMTEnabled() && mBranchReaders.size() > 1) {
+    // each branch is decompressed by a different task, reading the baskets
+    // from the file is serialised by ROOT itself
+    ROOT::TThreadExecutor executor;
+    executor.Foreach(readColumn, ROOT::TSeqU(mBranchReaders.size()));
+  } else {
+    for (auto i = 0u; i < mBranchReaders.size(); ++i) {
+      readColumn(i);
+    }
   }
 
   auto schema = std::make_shared<arrow::Schema>(fields, std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{mTableLabel}));
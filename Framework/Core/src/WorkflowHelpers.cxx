@@ -125,6 +125,16 @@ std::vector<TopoIndexInfo>
   return S;
 }
 
+/// AOD inputs which do not list the columns they use (e.g. not bound to a
+/// typed table) need all the columns of the table to be read
+InputSpec withAllColumnsIfUnspecified(InputSpec spec)
+{
+  if (std::none_of(spec.metadata.begin(), spec.metadata.end(), [](ConfigParamSpec const& m) { return m.name.rfind("column:", 0) == 0; })) {
+    spec.metadata.emplace_back(ConfigParamSpec{"column:*", VariantType::Bool, true, {"\"\""}});
+  }
+  return spec;
+}
+
 void WorkflowHelpers::addMissingOutputsToReader(std::vector<OutputSpec> const& providedOutputs,
                                                 std::vector<InputSpec> const& requestedInputs,
                                                 DataProcessorSpec& publisher)
@@ -175,7 +185,7 @@ void WorkflowHelpers::addMissingOutputsToSpawner(std::vector<OutputSpec> const&
         if (j == publisher.inputs.end()) {
           publisher.inputs.push_back(spec);
         }
-        DataSpecUtils::updateInputList(requestedAODs, std::move(spec));
+        DataSpecUtils::updateInputList(requestedAODs, withAllColumnsIfUnspecified(std::move(spec)));
       }
     }
   }
@@ -197,7 +207,7 @@ void WorkflowHelpers::addMissingOutputsToBuilder(std::vector<InputSpec> const& r
           publisher.inputs.push_back(spec);
         }
         if (DataSpecUtils::partialMatch(spec, AODOrigins)) {
-          DataSpecUtils::updateInputList(requestedAODs, std::move(spec));
+          DataSpecUtils::updateInputList(requestedAODs, withAllColumnsIfUnspecified(std::move(spec)));
         } else if (DataSpecUtils::partialMatch(spec, header::DataOrigin{"DYN"})) {
           DataSpecUtils::updateInputList(requestedDYNs, std::move(spec));
         }
@@ -296,6 +306,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
                 ConfigParamSpec{"aod-reader-json", VariantType::String, {"json configuration file"}},
                 ConfigParamSpec{"aod-parent-access-level", VariantType::String, {"Allow parent file access up to specified level. Default: no (0)"}},
                 ConfigParamSpec{"aod-parent-base-path-replacement", VariantType::String, {R"(Replace base path of parent files. Syntax: FROM;TO. E.g. "alien:///path/in/alien;/local/path". Enclose in "" on the command line.)"}},
+                ConfigParamSpec{"aod-reader-threads", VariantType::Int, 1, {"Number of threads to decompress the branches of a DF. If > 1, the next DF is prefetched"}},
                 ConfigParamSpec{"time-limit", VariantType::Int64, 0ll, {"Maximum run time limit in seconds"}},
                 ConfigParamSpec{"orbit-offset-enumeration", VariantType::Int64, 0ll, {"initial value for the orbit"}},
                 ConfigParamSpec{"orbit-multiplier-enumeration", VariantType::Int64, 0ll, {"multiplier to get the orbit from the counter"}},
@@ -420,7 +431,7 @@ void WorkflowHelpers::injectServiceDevices(WorkflowSpec& workflow, ConfigContext
           break;
       }
       if (DataSpecUtils::partialMatch(input, AODOrigins)) {
-        DataSpecUtils::updateInputList(requestedAODs, InputSpec{input});
+        DataSpecUtils::updateInputList(requestedAODs, withAllColumnsIfUnspecified(input));
       }
       if (DataSpecUtils::partialMatch(input, header::DataOrigin{"DYN"})) {
         DataSpecUtils::updateInputList(requestedDYNs, InputSpec{input});
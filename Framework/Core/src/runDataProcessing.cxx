@@ -27,6 +27,7 @@
 #include "Framework/DeviceExecution.h"
 #include "Framework/DeviceInfo.h"
 #include "Framework/DeviceMetricsInfo.h"
+#include "Framework/DeviceMetricsRing.h"
 #include "Framework/DeviceMetricsHelper.h"
 #include "Framework/DeviceConfigInfo.h"
 #include "Framework/DeviceSpec.h"
@@ -700,6 +701,18 @@ void spawnDevice(uv_loop_t* loop,
   // If we have a framework id, it means we have already been respawned
   // and that we are in a child. If not, we need to fork and re-exec, adding
   // the framework-id as one of the options.
+  // Shared memory ring the device will use to send us its numeric metrics
+  // without going through the text protocol. Can be disabled by
+  // setting DPL_DISABLE_METRICS_RING.
+  static int metricsRingCount = 0;
+  DeviceMetricsRing* metricsRing = nullptr;
+  auto metricsRingName = fmt::format("/dpl-metrics-{}-{}", getpid(), metricsRingCount++);
+  if (getenv("DPL_DISABLE_METRICS_RING") == nullptr) {
+    metricsRing = DeviceMetricsRingHelper::create(metricsRingName.c_str());
+    if (metricsRing == nullptr) {
+      LOGP(warning, "Unable to create metrics ring {} for {}. Using text metrics.", metricsRingName, spec.id);
+    }
+  }
   pid_t id = 0;
   id = fork();
   // We are the child: prepare options and reexec.
@@ -739,6 +752,11 @@ void spawnDevice(uv_loop_t* loop,
 
     auto portS = std::to_string(driverInfo.tracyPort);
     setenv("TRACY_PORT", portS.c_str(), 1);
+    if (metricsRing) {
+      setenv("DPL_METRICS_RING", metricsRingName.c_str(), 1);
+    } else {
+      unsetenv("DPL_METRICS_RING");
+    }
     for (auto& service : spec.services) {
       if (service.postForkChild != nullptr) {
         service.postForkChild(serviceRegistry);
@@ -792,7 +810,8 @@ void spawnDevice(uv_loop_t* loop,
                          .inputChannelMetricsViewIndex = Metric2DViewIndex{"oldest_possible_timeslice", 0, 0, {}},
                          .outputChannelMetricsViewIndex = Metric2DViewIndex{"oldest_possible_output", 0, 0, {}},
                          .tracyPort = driverInfo.tracyPort,
-                         .lastSignal = uv_hrtime() - 10000000});
+                         .lastSignal = uv_hrtime() - 10000000,
+                         .metricsRing = metricsRing});
   // create the offset using uv_hrtime
   timespec now;
   clock_gettime(CLOCK_REALTIME, &now);
@@ -1055,6 +1074,9 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
       ("signposts", bpo::value<std::string>()->default_value(defaultSignposts ? defaultSignposts : ""), "comma separated list of signposts to enable")                                     //
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
+      ("dpl-stream-threads", bpo::value<std::string>()->default_value("0"), "experimental: number of dedicated threads for the processing streams, only used when built with DPL_ENABLE_THREADING") //
+      ("dpl-stream-cpus", bpo::value<std::string>()->default_value(""), "comma separated list of cpus (e.g. 0-3,8) to pin the stream threads to")                                         //
+      ("dpl-stream-numa-node", bpo::value<std::string>()->default_value("-1"), "NUMA node whose cpus the stream threads are pinned to, if dpl-stream-cpus is not given")                   //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
       ("infologger-mode", bpo::value<std::string>()->default_value(defaultInfologgerMode), "O2_INFOLOGGER_MODE override");
@@ -1245,6 +1267,38 @@ std::vector<std::regex> getDumpableMetrics()
   return dumpableMetrics;
 }
 
+// Ingest the metrics the devices pushed in their shared memory rings,
+// and notify the metrics processing callbacks, like for the metrics
+// received via websocket.
+void drainMetricsRingsCallback(uv_timer_t* handle)
+{
+  auto* context = (DriverServerContext*)handle->data;
+  bool didProcessMetric = false;
+  auto updateMetricsViews = Metric2DViewIndex::getUpdater();
+  for (size_t di = 0; di < context->infos->size(); ++di) {
+    auto& info = (*context->infos)[di];
+    if (info.metricsRing == nullptr) {
+      continue;
+    }
+    std::array<Metric2DViewIndex*, 2> model = {&info.inputChannelMetricsViewIndex,
+                                               &info.outputChannelMetricsViewIndex};
+    auto newMetricCallback = [&](std::string const& name, MetricInfo const& metric, int value, size_t metricIndex) {
+      updateMetricsViews(model, name, metric, value, metricIndex);
+    };
+    didProcessMetric |= DeviceMetricsRingHelper::drain(*info.metricsRing, (*context->metrics)[di], newMetricCallback) > 0;
+  }
+  if (!didProcessMetric) {
+    return;
+  }
+  size_t timestamp = (uv_hrtime() - context->driver->startTime) / 1000000 + context->driver->startTimeMsFromEpoch;
+  for (auto& callback : *context->metricProcessingCallbacks) {
+    callback(context->registry, ServiceMetricsInfo{*context->metrics, *context->specs, *context->infos, context->driver->metrics, *context->driver}, timestamp);
+  }
+  for (auto& metricsInfo : *context->metrics) {
+    std::fill(metricsInfo.changed.begin(), metricsInfo.changed.end(), false);
+  }
+}
+
 void dumpMetricsCallback(uv_timer_t* handle)
 {
   auto* context = (DriverServerContext*)handle->data;
@@ -1517,6 +1571,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
 
   uv_timer_t metricDumpTimer;
   metricDumpTimer.data = &serverContext;
+  uv_timer_t metricsRingTimer;
+  metricsRingTimer.data = &serverContext;
+  uv_timer_init(loop, &metricsRingTimer);
   bool allChildrenGone = false;
   guiContext.allChildrenGone = &allChildrenGone;
   O2_SIGNPOST_ID_FROM_POINTER(sid, driver, loop);
@@ -2110,6 +2167,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
         handleSignals();
         handleChildrenStdio(&serverContext, forwardedStdin.str(), childFds, pollHandles);
+        uv_timer_start(&metricsRingTimer, drainMetricsRingsCallback, 100, 100);
         for (auto& callback : postScheduleCallbacks) {
           callback(serviceRegistry, {varmap});
         }
@@ -2226,6 +2284,12 @@ int runStateMachine(DataProcessorSpecs const& workflow,
         }
       } break;
       case DriverState::EXIT: {
+        uv_timer_stop(&metricsRingTimer);
+        drainMetricsRingsCallback(&metricsRingTimer);
+        for (auto& info : infos) {
+          DeviceMetricsRingHelper::release(info.metricsRing);
+          info.metricsRing = nullptr;
+        }
         if (ResourcesMonitoringHelper::isResourcesMonitoringEnabled(driverInfo.resourcesMonitoringInterval)) {
           if (driverInfo.resourcesMonitoringDumpInterval) {
             uv_timer_stop(&metricDumpTimer);
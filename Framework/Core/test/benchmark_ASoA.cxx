@@ -315,4 +315,75 @@ static void BM_ASoADynamicColumnCall(benchmark::State& state)
 }
 BENCHMARK(BM_ASoADynamicColumnCall)->Range(8, 8 << maxrange);
 
+SelectionVector createSelection(int64_t nRows, float fraction, unsigned int seed)
+{
+  std::default_random_engine e1(seed);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+  SelectionVector rows;
+  for (auto i = 0; i < nRows; ++i) {
+    if (uniform_dist(e1) < fraction) {
+      rows.push_back(i);
+    }
+  }
+  return rows;
+}
+
+// state.range(0): number of rows, state.range(1): percentage of selected rows
+// state.range(2): 0 - union, 1 - intersection of two selections of a Filtered table
+static void BM_ASoAFilteredCombine(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  auto fraction = state.range(1) / 100.f;
+  auto selection = createSelection(state.range(0), fraction, 1);
+  auto other = createSelection(state.range(0), fraction, 2);
+  const bool intersect = state.range(2);
+  for (auto _ : state) {
+    Filtered<TestTable> tests{{table}, SelectionVector{selection}};
+    if (intersect) {
+      tests *= other;
+    } else {
+      tests += other;
+    }
+    benchmark::DoNotOptimize(tests.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ASoAFilteredCombine)->ArgsProduct({{1 << 16, 1 << 20}, {1, 10, 50, 90}, {0, 1}});
+
+// state.range(0): number of rows, state.range(1): percentage of selected rows
+static void BM_ASoAFilteredLoop(benchmark::State& state)
+{
+  std::default_random_engine e1(1234567891);
+  std::uniform_real_distribution<float> uniform_dist(0, 1);
+
+  TableBuilder builder;
+  auto rowWriter = builder.persist<float, float, float>({"x", "y", "z"});
+  for (auto i = 0; i < state.range(0); ++i) {
+    rowWriter(0, uniform_dist(e1), uniform_dist(e1), uniform_dist(e1));
+  }
+  auto table = builder.finalize();
+
+  Filtered<TestTable> tests{{table}, createSelection(state.range(0), state.range(1) / 100.f, 1)};
+  for (auto _ : state) {
+    float sum = 0;
+    for (auto& test : tests) {
+      sum += test.x() + test.y();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * tests.size());
+}
+
+BENCHMARK(BM_ASoAFilteredLoop)->ArgsProduct({{1 << 16, 1 << 20}, {1, 10, 50, 90}});
+
 BENCHMARK_MAIN();
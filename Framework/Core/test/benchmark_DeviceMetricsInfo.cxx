@@ -10,8 +10,11 @@
 // or submit itself to any jurisdiction.
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <memory>
 #include <regex>
 
 // This is the fastest we could ever get.
@@ -164,4 +167,53 @@ static void BM_ProcessMismatchedMetric(benchmark::State& state)
 
 BENCHMARK(BM_ProcessMismatchedMetric);
 
+// Full path of 1000 int metrics from the device to the driver store,
+// using the text protocol: formatting, parsing and processing.
+static void BM_IngestTextMetrics(benchmark::State& state)
+{
+  using namespace o2::framework;
+  ParsedMetricMatch match;
+  DeviceMetricsInfo info;
+  std::array<char, 4096> buffer;
+  size_t nMetrics = 0;
+
+  for (auto _ : state) {
+    for (int i = 0; i < 1000; ++i) {
+      auto end = fmt::format_to(buffer.begin(), "[METRIC] key{},0 {} {} hostname=test.cern.ch\n", i % 16, i, 1789372894 + i);
+      *end = '\0';
+      DeviceMetricsHelper::parseMetric(std::string_view(buffer.data(), end - buffer.begin()), match);
+      DeviceMetricsHelper::processMetric(match, info);
+    }
+    nMetrics += 1000;
+  }
+  state.SetItemsProcessed(nMetrics);
+}
+
+BENCHMARK(BM_IngestTextMetrics);
+
+// Same as above, via the binary metrics ring.
+static void BM_IngestRingMetrics(benchmark::State& state)
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  auto memory = std::make_unique<std::aligned_storage_t<sizeof(DeviceMetricsRing), alignof(DeviceMetricsRing)>>();
+  auto* ring = DeviceMetricsRing::init(memory.get(), "/benchmark-metrics-ring");
+  std::array<std::string, 16> names;
+  for (size_t i = 0; i < names.size(); ++i) {
+    names[i] = fmt::format("key{}", i);
+  }
+  size_t nMetrics = 0;
+
+  for (auto _ : state) {
+    for (int i = 0; i < 1000; ++i) {
+      ring->push<int>(names[i % 16], i, 1789372894 + i);
+    }
+    DeviceMetricsRingHelper::drain(*ring, info);
+    nMetrics += 1000;
+  }
+  state.SetItemsProcessed(nMetrics);
+}
+
+BENCHMARK(BM_IngestRingMetrics);
+
 BENCHMARK_MAIN();
@@ -17,6 +17,8 @@
 #include <vector>
 
 #include <TFile.h>
+#include <TROOT.h>
+#include <fmt/format.h>
 
 using namespace o2::framework;
 using namespace arrow;
@@ -93,4 +95,54 @@ static void BM_TreeToTable(benchmark::State& state)
 
 BENCHMARK(BM_TreeToTable)->Range(8, 8 << maxrange);
 
+// state.range(0): number of rows
+// state.range(1): number of threads used to decompress the branches (ROOT implicit MT)
+static void BM_TreeToTableParallel(benchmark::State& state)
+{
+  constexpr int nColumns = 16;
+  const int nThreads = state.range(1);
+
+  // create a tree with nColumns compressed float branches
+  std::default_random_engine e1(1234567891);
+  std::normal_distribution<float> rf(5., 2.);
+  {
+    TFile fout("tree2tableMT.root", "RECREATE");
+    TTree tree("tree2table", "tree2table");
+    std::vector<float> values(nColumns);
+    for (auto i = 0; i < nColumns; ++i) {
+      tree.Branch(fmt::format("f{}", i).c_str(), &values[i], fmt::format("f{}/F", i).c_str());
+    }
+    for (auto i = 0; i < state.range(0); ++i) {
+      for (auto& value : values) {
+        value = rf(e1);
+      }
+      tree.Fill();
+    }
+    tree.Write();
+    fout.Close();
+  }
+
+  if (nThreads > 1) {
+    ROOT::EnableImplicitMT(nThreads);
+  }
+  for (auto _ : state) {
+    TFile f("tree2tableMT.root", "READ");
+    auto tr = (TTree*)f.Get("tree2table");
+    TreeToTable tr2ta;
+    tr2ta.addAllColumns(tr);
+    tr2ta.fill(tr);
+    auto ta = tr2ta.finalize();
+    benchmark::DoNotOptimize(ta);
+    delete tr;
+    f.Close();
+  }
+  if (nThreads > 1) {
+    ROOT::DisableImplicitMT();
+  }
+
+  state.SetBytesProcessed(state.iterations() * state.range(0) * nColumns * sizeof(float));
+}
+
+BENCHMARK(BM_TreeToTableParallel)->Args({1 << 20, 1})->Args({1 << 20, 2})->Args({1 << 20, 4})->Args({1 << 20, 8})->Unit(benchmark::kMillisecond)->UseRealTime();
+
 BENCHMARK_MAIN();
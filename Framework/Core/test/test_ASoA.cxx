@@ -1357,3 +1357,39 @@ TEST_CASE("TestCombinedGetter")
     ++count;
   }
 }
+
+TEST_CASE("TestSelectionsCombination")
+{
+  // sparse selections are merged, dense ones combined through a bitmap
+  for (auto nRows : {1000, 20}) {
+    SelectionVector even;
+    SelectionVector third;
+    for (auto i = 0; i < nRows; ++i) {
+      if (i % 2 == 0) {
+        even.push_back(i);
+      }
+      if (i % 3 == 0) {
+        third.push_back(i);
+      }
+    }
+    SelectionVector expectedUnion;
+    SelectionVector expectedIntersection;
+    std::set_union(even.begin(), even.end(), third.begin(), third.end(), std::back_inserter(expectedUnion));
+    std::set_intersection(even.begin(), even.end(), third.begin(), third.end(), std::back_inserter(expectedIntersection));
+    REQUIRE(sumSelections(even, third, nRows) == expectedUnion);
+    REQUIRE(intersectSelections(even, third, nRows) == expectedIntersection);
+    REQUIRE(sumSelections(even, third, 100 * nRows) == expectedUnion);
+    REQUIRE(intersectSelections(even, third, 100 * nRows) == expectedIntersection);
+  }
+
+  SelectionVector few{5, 500, 999};
+  SelectionVector many(1000);
+  std::iota(many.begin(), many.end(), 0);
+  REQUIRE(intersectSelections(few, many, 1000) == few);
+  REQUIRE(intersectSelections(many, few, 1000) == few);
+
+  // rows past the declared size do not fit in the bitmap and fall back to the merge
+  SelectionVector beyond{0, 1, 2, 1500};
+  REQUIRE(sumSelections(beyond, many, 1000).back() == 1500);
+  REQUIRE(intersectSelections(beyond, many, 1000) == SelectionVector{0, 1, 2});
+}
@@ -1400,3 +1400,69 @@ TEST_CASE("BlockCombinationsCounters")
     previousEvent = c0.index();
   }
 }
+
+TEST_CASE("ParallelBlockCombinations")
+{
+  TableBuilder builderA;
+  auto rowWriterA = builderA.persist<int32_t, int32_t, float>({"x", "y", "floatZ"});
+  rowWriterA(0, 0, 25, -6.0f);
+  rowWriterA(0, 1, 18, 0.0f);
+  rowWriterA(0, 2, 48, 8.0f);
+  rowWriterA(0, 3, 103, 2.0f);
+  rowWriterA(0, 4, 28, -6.0f);
+  rowWriterA(0, 5, 102, 2.0f);
+  rowWriterA(0, 6, 12, 0.0f);
+  rowWriterA(0, 7, 24, -7.0f);
+  rowWriterA(0, 8, 41, 8.0f);
+  rowWriterA(0, 9, 49, 8.0f);
+  auto tableA = builderA.finalize();
+
+  using TestA = o2::soa::Table<o2::soa::Index<>, test::X, test::Y, test::FloatZ>;
+  TestA testA{tableA};
+
+  // Grouped data:
+  // [3, 5] [0, 4, 7], [1, 6], [2, 8, 9]
+  std::vector<double> yBins{VARIABLE_WIDTH, 0, 5, 10, 20, 30, 40, 50, 101};
+  std::vector<double> zBins{VARIABLE_WIDTH, -7.0, -5.0, -3.0, -1.0, 1.0, 3.0, 5.0, 7.0};
+  ColumnBinningPolicy<test::Y, test::FloatZ> pairBinning{{yBins, zBins}, false};
+
+  std::vector<std::tuple<int32_t, int32_t>> expectedPairs;
+  for (auto& [c0, c1] : selfCombinations(pairBinning, 2, -1, testA, testA)) {
+    expectedPairs.emplace_back(c0.x(), c1.x());
+  }
+  std::vector<std::tuple<int32_t, int32_t, int32_t>> expectedTriples;
+  for (auto& [c0, c1, c2] : combinations(CombinationsBlockUpperSameIndexPolicy(pairBinning, 2, -1, testA, testA, testA))) {
+    expectedTriples.emplace_back(c0.x(), c1.x(), c2.x());
+  }
+  std::sort(expectedPairs.begin(), expectedPairs.end());
+  std::sort(expectedTriples.begin(), expectedTriples.end());
+
+  for (int nThreads : {1, 3, 8}) {
+    // per thread outputs, merged at the end
+    std::vector<std::vector<std::tuple<int32_t, int32_t>>> pairs(nThreads);
+    parallelSelfCombinations(
+      nThreads, pairBinning, 2, -1, [&](int threadId, auto& comb) {
+        auto& [c0, c1] = comb;
+        pairs[threadId].emplace_back(c0.x(), c1.x());
+      },
+      testA, testA);
+    std::vector<std::tuple<int32_t, int32_t>> allPairs;
+    for (auto& threadPairs : pairs) {
+      allPairs.insert(allPairs.end(), threadPairs.begin(), threadPairs.end());
+    }
+    std::sort(allPairs.begin(), allPairs.end());
+    REQUIRE(allPairs == expectedPairs);
+
+    std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> triples(nThreads);
+    parallelCombinations(nThreads, CombinationsBlockUpperSameIndexPolicy(pairBinning, 2, -1, testA, testA, testA), [&](int threadId, auto& comb) {
+      auto& [c0, c1, c2] = comb;
+      triples[threadId].emplace_back(c0.x(), c1.x(), c2.x());
+    });
+    std::vector<std::tuple<int32_t, int32_t, int32_t>> allTriples;
+    for (auto& threadTriples : triples) {
+      allTriples.insert(allTriples.end(), threadTriples.begin(), threadTriples.end());
+    }
+    std::sort(allTriples.begin(), allTriples.end());
+    REQUIRE(allTriples == expectedTriples);
+  }
+}
@@ -218,6 +218,45 @@ TEST_CASE("AdaptorCompilation")
   REQUIRE(task12.inputs.size() == 3);
 }
 
+TEST_CASE("TestColumnsMetadata")
+{
+  auto cfgc = makeEmptyConfigContext();
+  auto columns = [](InputSpec const& input) {
+    std::vector<std::string> labels;
+    for (auto& m : input.metadata) {
+      if (m.name.rfind("column:", 0) == 0) {
+        labels.emplace_back(m.name.substr(7));
+      }
+    }
+    return labels;
+  };
+
+  // the persistent columns of the filtered table, including the one used in the filter, but not the dynamic ones
+  auto task6 = adaptAnalysisTask<FTask>(*cfgc, TaskName{"test6"});
+  REQUIRE(columns(task6.inputs[0]) == std::vector<std::string>{"fFoo", "fBar"});
+
+  // every table of a join lists its own columns
+  auto task9 = adaptAnalysisTask<ITask>(*cfgc, TaskName{"test9"});
+  for (auto& input : task9.inputs) {
+    if (input.binding == "Bars") {
+      REQUIRE(columns(input) == std::vector<std::string>{"fBar"});
+    } else if (input.binding == "XYZ") {
+      REQUIRE(columns(input) == std::vector<std::string>{"fX", "fY", "fZ"});
+    }
+  }
+
+  // the spawned extension is not read from the file
+  auto task4 = adaptAnalysisTask<DTask>(*cfgc, TaskName{"test4"});
+  REQUIRE(columns(task4.inputs[0]).empty());
+  REQUIRE(columns(task4.inputs[1]).size() > 0);
+
+  // the columns requested by several tasks are merged, a request of the full table is kept
+  std::vector<InputSpec> requested{task6.inputs[0]};
+  DataSpecUtils::updateInputList(requested, InputSpec{"FooBars", "AOD", "FOOBAR", 0, Lifetime::Timeframe, {ConfigParamSpec{"column:*", VariantType::Bool, true, {"\"\""}}}});
+  REQUIRE(requested.size() == 1);
+  REQUIRE(columns(requested[0]) == std::vector<std::string>{"*", "fBar", "fFoo"});
+}
+
 TEST_CASE("TestPartitionIteration")
 {
   TableBuilder builderA;
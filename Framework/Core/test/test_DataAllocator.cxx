@@ -316,6 +316,11 @@ DataProcessorSpec getSinkSpec()
     ASSERT_ERROR((object12[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
     // forward the read-only span on a different route
     pc.outputs().snapshot(Output{"TST", "MSGABLVECTORCPY", 0}, object12);
+    // and forward the message holding it by reference on another route, without copying the payload
+    auto* message12 = pc.inputs().getPayloadMessageByPos(pc.inputs().getPos("input12"));
+    ASSERT_ERROR(message12 != nullptr);
+    ASSERT_ERROR(message12->GetSize() == 2 * sizeof(o2::test::TriviallyCopyable));
+    pc.outputs().shallowSnapshot(Output{"TST", "MSGABLVECTORREF", 0}, *message12);
 
     LOG(info) << "extracting TNamed object from input13";
     auto object13 = pc.inputs().get<TNamed*>("input13");
@@ -387,7 +392,8 @@ DataProcessorSpec getSinkSpec()
                             InputSpec{"inputPODvector", "TST", "PODVECTOR", 0, Lifetime::Timeframe},
                             InputSpec{"inputMP", ConcreteDataTypeMatcher{"TST", "MULTIPARTS"}, Lifetime::Timeframe},
                             InputSpec{"inputPtrVec", "TST", "ROOTSERLZDPTRVEC", 0, Lifetime::Timeframe}},
-                           Outputs{OutputSpec{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe}},
+                           Outputs{OutputSpec{"TST", "MSGABLVECTORCPY", 0, Lifetime::Timeframe},
+                                   OutputSpec{"TST", "MSGABLVECTORREF", 0, Lifetime::Timeframe}},
                            AlgorithmSpec(processingFct)};
 }
 
@@ -423,13 +429,19 @@ DataProcessorSpec getSpectatorSinkSpec()
     ASSERT_ERROR(object12.size() == 2);
     ASSERT_ERROR((object12[0] == o2::test::TriviallyCopyable{42, 23, 0xdead}));
     ASSERT_ERROR((object12[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
+    LOG(info) << "extracting the gsl::span<o2::test::TriviallyCopyable> forwarded by reference from input12ref";
+    auto object12ref = pc.inputs().get<gsl::span<o2::test::TriviallyCopyable>>("input12ref");
+    ASSERT_ERROR(object12ref.size() == 2);
+    ASSERT_ERROR((object12ref[0] == o2::test::TriviallyCopyable{42, 23, 0xdead}));
+    ASSERT_ERROR((object12ref[1] == o2::test::TriviallyCopyable{10, 20, 0xacdc}));
 
     pc.services().get<ControlService>().readyToQuit(QuitRequest::Me);
   };
 
   return DataProcessorSpec{"spectator-sink", // name of the processor
                            {InputSpec{"inputMP", ConcreteDataTypeMatcher{"TST", "MULTIPARTS"}, Lifetime::Timeframe},
-                            InputSpec{"input12", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORCPY"}, Lifetime::Timeframe}},
+                            InputSpec{"input12", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORCPY"}, Lifetime::Timeframe},
+                            InputSpec{"input12ref", ConcreteDataTypeMatcher{"TST", "MSGABLVECTORREF"}, Lifetime::Timeframe}},
                            Outputs{},
                            AlgorithmSpec(processingFct)};
 }
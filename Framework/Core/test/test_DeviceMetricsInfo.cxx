@@ -11,8 +11,10 @@
 
 #include "Framework/DeviceMetricsInfo.h"
 #include "Framework/DeviceMetricsHelper.h"
+#include "Framework/DeviceMetricsRing.h"
 #include <catch_amalgamated.hpp>
 #include <catch_amalgamated.hpp>
+#include <memory>
 #include <regex>
 #include <string_view>
 
@@ -515,3 +517,61 @@ TEST_CASE("TestHelpers")
   REQUIRE(metric2 == 0);
   REQUIRE(metric3 == 1);
 }
+
+TEST_CASE("TestMetricsRing")
+{
+  using namespace o2::framework;
+  auto buffer = std::make_unique<std::aligned_storage_t<sizeof(DeviceMetricsRing), alignof(DeviceMetricsRing)>>();
+  auto* ring = DeviceMetricsRing::init(buffer.get(), "/test-metrics-ring");
+  REQUIRE(ring->push<int>("bkey", 12, 1789372894));
+  REQUIRE(ring->push<float>("akey", 16.5f, 1789372895));
+  REQUIRE(ring->push<uint64_t>("ckey", 1ULL << 40, 1789372896));
+  REQUIRE(ring->push<int>("data_relayer/1", 1, 1789372897));
+  REQUIRE(ring->push<int>("bkey", 13, 1789372898));
+  REQUIRE(ring->push<int>(std::string(MetricRecord::MAX_NAME_SIZE + 1, 'x'), 1, 1789372899) == false);
+
+  DeviceMetricsInfo info;
+  REQUIRE(DeviceMetricsRingHelper::drain(*ring, info) == 5);
+  REQUIRE(DeviceMetricsRingHelper::drain(*ring, info) == 0);
+  REQUIRE(info.metrics.size() == 4);
+  auto bkey = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  REQUIRE(info.metrics[bkey].type == MetricType::Int);
+  REQUIRE(info.metrics[bkey].filledMetrics == 2);
+  REQUIRE(info.intMetrics[info.metrics[bkey].storeIdx][0] == 12);
+  REQUIRE(info.intMetrics[info.metrics[bkey].storeIdx][1] == 13);
+  REQUIRE(info.intTimestamps[info.metrics[bkey].storeIdx][1] == 1789372898);
+  auto akey = DeviceMetricsHelper::metricIdxByName("akey", info);
+  REQUIRE(info.metrics[akey].type == MetricType::Float);
+  REQUIRE(info.floatMetrics[info.metrics[akey].storeIdx][0] == 16.5f);
+  auto ckey = DeviceMetricsHelper::metricIdxByName("ckey", info);
+  REQUIRE(info.metrics[ckey].type == MetricType::Uint64);
+  REQUIRE(info.uint64Metrics[info.metrics[ckey].storeIdx][0] == (1ULL << 40));
+  auto relayer = DeviceMetricsHelper::metricIdxByName("data_relayer/1", info);
+  REQUIRE(info.metrics[relayer].type == MetricType::Enum);
+
+  // Once full, the ring refuses new metrics until it is drained.
+  for (size_t i = 0; i < DeviceMetricsRing::CAPACITY; ++i) {
+    REQUIRE(ring->push<int>("bkey", i, 1789372900 + i));
+  }
+  REQUIRE(ring->push<int>("bkey", 0, 1789372900) == false);
+  REQUIRE(DeviceMetricsRingHelper::drain(*ring, info) == DeviceMetricsRing::CAPACITY);
+  REQUIRE(ring->push<int>("bkey", 0, 1789372900));
+}
+
+TEST_CASE("TestEnumMetrics")
+{
+  using namespace o2::framework;
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("data_relayer/1"));
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("data_relayer/1-3,0 1 1789372894"));
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("data_relayer/w") == false);
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("data_relayer/h") == false);
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("data_relayer/") == false);
+  REQUIRE(DeviceMetricsHelper::isEnumMetric("bkey") == false);
+
+  // Text and ring metrics agree on the type.
+  ParsedMetricMatch match;
+  REQUIRE(DeviceMetricsHelper::parseMetric("[METRIC] data_relayer/2,0 1 1789372894 hostname=test.cern.ch", match));
+  REQUIRE(match.type == MetricType::Enum);
+  REQUIRE(DeviceMetricsHelper::parseMetric("[METRIC] data_relayer/w,0 1 1789372894 hostname=test.cern.ch", match));
+  REQUIRE(match.type == MetricType::Int);
+}
@@ -65,4 +65,12 @@ TEST_CASE("TestInputSpan")
     }
     routeNo++;
   }
+
+  // Without a message store there is no payload message to share.
+  REQUIRE(span.payloadMessage(0) == nullptr);
+  std::vector<fair::mq::Message*> messages{reinterpret_cast<fair::mq::Message*>(0x10), reinterpret_cast<fair::mq::Message*>(0x20)};
+  span.setPayloadMessageGetter([&messages](size_t i, size_t part) { return part == 0 ? messages[i % 2] : nullptr; });
+  REQUIRE(span.payloadMessage(0) == messages[0]);
+  REQUIRE(span.payloadMessage(1) == messages[1]);
+  REQUIRE(span.payloadMessage(1, 1) == nullptr);
 }
@@ -0,0 +1,62 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "Framework/StreamExecutor.h"
+#include <catch_amalgamated.hpp>
+#include <uv.h>
+#include <atomic>
+#include <thread>
+
+using namespace o2::framework;
+
+TEST_CASE("TestParseCPUList")
+{
+  REQUIRE(StreamExecutor::parseCPUList("").empty());
+  REQUIRE(StreamExecutor::parseCPUList("3") == std::vector<int>{3});
+  REQUIRE(StreamExecutor::parseCPUList("0-3,8") == std::vector<int>{0, 1, 2, 3, 8});
+  REQUIRE(StreamExecutor::parseCPUList(" 1 , 4-5\n") == std::vector<int>{1, 4, 5});
+  REQUIRE_THROWS(StreamExecutor::parseCPUList("a-b"));
+}
+
+TEST_CASE("TestStreamExecutor")
+{
+  uv_loop_t loop;
+  uv_loop_init(&loop);
+  constexpr int N = 100;
+  std::vector<int> done[3];
+  std::thread::id workerIds[3];
+  int completions = 0;
+  {
+    StreamExecutor executor(&loop, 2);
+    REQUIRE(executor.threads() == 2);
+    for (int i = 0; i < N; ++i) {
+      for (int s = 0; s < 3; ++s) {
+        executor.submit(
+          s, [&, s, i]() { done[s].push_back(i); workerIds[s] = std::this_thread::get_id(); }, [&completions]() { completions++; });
+      }
+    }
+    while (completions < 3 * N) {
+      uv_run(&loop, UV_RUN_ONCE);
+    }
+  }
+  uv_run(&loop, UV_RUN_NOWAIT);
+  REQUIRE(uv_loop_close(&loop) == 0);
+  // Work for a given stream is executed in order.
+  for (int s = 0; s < 3; ++s) {
+    REQUIRE(done[s].size() == N);
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(done[s][i] == i);
+    }
+  }
+  // Streams 0 and 2 share the same thread.
+  REQUIRE(workerIds[0] == workerIds[2]);
+  REQUIRE(workerIds[0] != workerIds[1]);
+}
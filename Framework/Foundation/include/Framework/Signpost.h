@@ -197,6 +197,33 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // The name of the log, as registered in the list of logs.
+  char const* name = nullptr;
+};
+
+// Binary trace backend. When enabled, the signposts of the enabled logs are not
+// formatted and printed, but recorded as fixed size entries in per-thread ring buffers,
+// which can later be dumped as a Chrome / Perfetto JSON trace.
+struct _o2_trace_entry_t {
+  // Nanoseconds from the steady clock.
+  uint64_t timestamp = 0;
+  int64_t id = 0;
+  // Like for os_signpost, names are expected to be string literals, so we only keep the pointer.
+  char const* name = nullptr;
+  _o2_log_t* log = nullptr;
+  // 'b' for interval begin, 'e' for interval end, 'n' for events.
+  char type = 0;
+};
+
+// A single producer ring buffer. Only the owning thread writes to it, the oldest
+// entries are overwritten once it is full.
+struct _o2_trace_buffer_t {
+  static constexpr size_t N = 1 << 15;
+  std::atomic<uint64_t> head = 0;
+  int tid = 0;
+  _o2_trace_buffer_t* next = nullptr;
+  _o2_trace_entry_t entries[N];
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -206,6 +233,20 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+std::atomic<bool>& _o2_signpost_trace_enabled();
+void _o2_signpost_trace_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char type);
+
+extern "C" {
+// Switch between the text and the binary trace backend for all the enabled logs.
+// Binary tracing is also enabled by setting O2_SIGNPOSTS_TRACE=<prefix> in the environment,
+// in which case the trace is dumped at exit in <prefix>-<pid>.json.
+void o2_signpost_trace_enable(bool enable);
+// Dump the content of all the trace ring buffers as a Chrome / Perfetto JSON trace.
+// Returns the number of dumped entries or -1 if the file could not be opened.
+// Entries which are overwritten while dumping might be inconsistent, so
+// preferably dump when the signposts are quiescent.
+int o2_signpost_trace_dump(char const* filename);
+}
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -231,9 +272,12 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 // Implementation start here. Include this file with O2_SIGNPOST_IMPLEMENTATION defined in one file of your
 // project.
 #ifdef O2_SIGNPOST_IMPLEMENTATION
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <unistd.h>
 #include "Framework/RuntimeError.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
 
@@ -293,8 +337,115 @@ bool _o2_lock_free_stack_pop(_o2_lock_free_stack& stack, int& value, bool spin)
   }
 }
 
+std::atomic<bool>& _o2_signpost_trace_enabled()
+{
+  static std::atomic<bool> enabled = false;
+  return enabled;
+}
+
+// All the trace buffers ever created. They are never deleted, so that
+// we can still dump the entries of threads which are gone.
+std::atomic<_o2_trace_buffer_t*>& _o2_get_trace_buffers()
+{
+  static std::atomic<_o2_trace_buffer_t*> first = nullptr;
+  return first;
+}
+
+void _o2_signpost_trace_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char type)
+{
+  static thread_local _o2_trace_buffer_t* buffer = nullptr;
+  if (O2_BUILTIN_UNLIKELY(buffer == nullptr)) {
+    static std::atomic<int> nextTid = 0;
+    buffer = new _o2_trace_buffer_t();
+    buffer->tid = nextTid++;
+    buffer->next = _o2_get_trace_buffers().load();
+    while (!_o2_get_trace_buffers().compare_exchange_weak(buffer->next, buffer,
+                                                          std::memory_order_release,
+                                                          std::memory_order_relaxed)) {
+    }
+  }
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  auto& entry = buffer->entries[head & (_o2_trace_buffer_t::N - 1)];
+  entry.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  entry.id = id.value;
+  entry.name = name;
+  entry.log = log;
+  entry.type = type;
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+// Print a JSON string, escaping what needs to be escaped.
+void _o2_trace_print_json_string(FILE* f, char const* s)
+{
+  fputc('"', f);
+  for (; s && *s; ++s) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', f);
+      fputc(*s, f);
+    } else if ((unsigned char)*s >= 0x20) {
+      fputc(*s, f);
+    }
+  }
+  fputc('"', f);
+}
+
+extern "C" {
+void o2_signpost_trace_enable(bool enable)
+{
+  _o2_signpost_trace_enabled().store(enable, std::memory_order_relaxed);
+}
+
+int o2_signpost_trace_dump(char const* filename)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == nullptr) {
+    return -1;
+  }
+  int pid = getpid();
+  int count = 0;
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  char const* separator = "";
+  for (auto* buffer = _o2_get_trace_buffers().load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > _o2_trace_buffer_t::N ? head - _o2_trace_buffer_t::N : 0;
+    fprintf(f, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"signposts-%d\"}}",
+            separator, pid, buffer->tid, buffer->tid);
+    separator = ",\n";
+    for (uint64_t i = first; i < head; ++i) {
+      auto const& entry = buffer->entries[i & (_o2_trace_buffer_t::N - 1)];
+      fprintf(f, "%s{\"ph\":\"%c\",\"name\":", separator, entry.type);
+      _o2_trace_print_json_string(f, entry.name);
+      fprintf(f, ",\"cat\":");
+      _o2_trace_print_json_string(f, entry.log ? entry.log->name : nullptr);
+      fprintf(f, ",\"id\":\"0x%" PRIx64 "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+              (uint64_t)entry.id, entry.timestamp / 1000., pid, buffer->tid);
+      count++;
+    }
+  }
+  fprintf(f, "\n]}\n");
+  fclose(f);
+  return count;
+}
+}
+
 void* _o2_log_create(char const* name, int defaultStacktrace)
 {
+  // Enable the binary trace backend if requested via the environment.
+  // This is done only once, for the first log which gets created.
+  static bool traceFromEnv = []() -> bool {
+    char const* prefix = getenv("O2_SIGNPOSTS_TRACE");
+    if (prefix == nullptr || prefix[0] == 0) {
+      return false;
+    }
+    o2_signpost_trace_enable(true);
+    atexit([]() {
+      char filename[4096];
+      snprintf(filename, sizeof(filename), "%s-%d.json", getenv("O2_SIGNPOSTS_TRACE"), getpid());
+      o2_signpost_trace_dump(filename);
+    });
+    return true;
+  }();
+  (void)traceFromEnv;
   // iterate over the list of logs and check if we already have
   // one with the same name.
   o2_log_handle_t* handle = o2_walk_logs([](char const* currentName, void* log, void* context) -> bool {
@@ -332,6 +483,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   }
 #endif
   newHandle->name = strdup(name);
+  log->name = newHandle->name;
   newHandle->next = o2_get_logs_tail().load();
   // Until I manage to replace the log I have in next, keep trying.
   // Notice this does not protect against two threads trying to insert
@@ -349,6 +501,10 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
 // If the slot is empty, it will return the id and increment the indentation level.
 void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...)
 {
+  if (O2_BUILTIN_UNLIKELY(_o2_signpost_trace_enabled().load(std::memory_order_relaxed))) {
+    _o2_signpost_trace_record(log, id, name, 'n');
+    return;
+  }
   va_list args;
   va_start(args, format);
 
@@ -383,6 +539,10 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 // If the slot is empty, it will return the id and increment the indentation level.
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...)
 {
+  if (O2_BUILTIN_UNLIKELY(_o2_signpost_trace_enabled().load(std::memory_order_relaxed))) {
+    _o2_signpost_trace_record(log, id, name, 'b');
+    return;
+  }
   va_list args;
   va_start(args, format);
   // This is a unique slot for this interval.
@@ -406,6 +566,10 @@ void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char cons
   if (log->stacktrace == 0) {
     return;
   }
+  if (O2_BUILTIN_UNLIKELY(_o2_signpost_trace_enabled().load(std::memory_order_relaxed))) {
+    _o2_signpost_trace_record(log, id, name, 'e');
+    return;
+  }
   // Find the index of the activity
   int i = 0;
   for (i = 0; i < log->ids.size(); ++i) {
@@ -0,0 +1,52 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include <catch_amalgamated.hpp>
+#include "Framework/Signpost.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+O2_DECLARE_DYNAMIC_LOG(test_SignpostTrace);
+
+TEST_CASE("TestSignpostTrace")
+{
+  O2_LOG_ENABLE(test_SignpostTrace);
+  o2_signpost_trace_enable(true);
+  auto emit = []() {
+    for (int i = 0; i < 10; ++i) {
+      O2_SIGNPOST_ID_GENERATE(sid, test_SignpostTrace);
+      O2_SIGNPOST_START(test_SignpostTrace, sid, "trace_interval", "Interval %d", i);
+      O2_SIGNPOST_EVENT_EMIT(test_SignpostTrace, sid, "trace_event", "Event %d", i);
+      O2_SIGNPOST_END(test_SignpostTrace, sid, "trace_interval", "Interval %d", i);
+    }
+  };
+  std::thread other(emit);
+  emit();
+  other.join();
+  o2_signpost_trace_enable(false);
+  O2_LOG_DISABLE(test_SignpostTrace);
+
+  char filename[256];
+  snprintf(filename, sizeof(filename), "/tmp/test_SignpostTrace-%d.json", getpid());
+  REQUIRE(o2_signpost_trace_dump(filename) == 60);
+  std::ifstream in(filename);
+  std::stringstream content;
+  content << in.rdbuf();
+  auto json = content.str();
+  REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(json.find("\"ph\":\"b\",\"name\":\"trace_interval\",\"cat\":\"ch.cern.aliceo2.test_SignpostTrace\"") != std::string::npos);
+  REQUIRE(json.find("\"ph\":\"e\",\"name\":\"trace_interval\"") != std::string::npos);
+  REQUIRE(json.find("\"ph\":\"n\",\"name\":\"trace_event\"") != std::string::npos);
+  unlink(filename);
+}
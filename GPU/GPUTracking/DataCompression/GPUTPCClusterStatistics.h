@@ -30,11 +30,11 @@ class GPUTPCClusterStatistics
 {
  public:
 #ifndef GPUCA_HAVE_O2HEADERS
-  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param){};
+  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, int nThreads){};
   void Finish(){};
 #else
   static constexpr unsigned int NSLICES = GPUCA_NSLICES;
-  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param);
+  void RunStatistics(const o2::tpc::ClusterNativeAccess* clustersNative, const o2::tpc::CompressedClusters* clustersCompressed, const GPUParam& param, int nThreads);
   void Finish();
 
  protected:
@@ -19,13 +19,13 @@
 #include "GPULogging.h"
 #include <algorithm>
 #include <cstring>
-#include <atomic>
+#include <memory>
 #include "TPCClusterDecompressor.inc"
 
 using namespace GPUCA_NAMESPACE::gpu;
 using namespace o2::tpc;
 
-int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec)
+int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, int nThreads, bool deterministicRec)
 {
   CompressedClusters c;
   const CompressedClusters* p;
@@ -35,10 +35,10 @@ int TPCClusterDecompressor::decompress(const CompressedClustersFlat* clustersCom
     c = *clustersCompressed;
     p = &c;
   }
-  return decompress(p, clustersNative, allocator, param, deterministicRec);
+  return decompress(p, clustersNative, allocator, param, nThreads, deterministicRec);
 }
 
-int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, bool deterministicRec)
+int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompressed, o2::tpc::ClusterNativeAccess& clustersNative, std::function<o2::tpc::ClusterNative*(size_t)> allocator, const GPUParam& param, int nThreads, bool deterministicRec)
 {
   if (clustersCompressed->nTracks && clustersCompressed->solenoidBz != -1e6f && clustersCompressed->solenoidBz != param.bzkG) {
     throw std::runtime_error("Configured solenoid Bz does not match value used for track model encoding");
@@ -46,35 +46,109 @@ int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompres
   if (clustersCompressed->nTracks && clustersCompressed->maxTimeBin != -1e6 && clustersCompressed->maxTimeBin != param.par.continuousMaxTimeBin) {
     throw std::runtime_error("Configured max time bin does not match value used for track model encoding");
   }
-  std::vector<ClusterNative> clusters[NSLICES][GPUCA_ROW_COUNT];
-  std::atomic_flag locks[NSLICES][GPUCA_ROW_COUNT];
-  for (unsigned int i = 0; i < NSLICES * GPUCA_ROW_COUNT; i++) {
-    (&locks[0][0])[i].clear();
-  }
-  unsigned int offset = 0, lasti = 0;
+  auto nUnattached = [clustersCompressed](unsigned int i, unsigned int j) -> unsigned int {
+    return (i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
+  };
   const unsigned int maxTime = param.par.continuousMaxTimeBin > 0 ? ((param.par.continuousMaxTimeBin + 1) * ClusterNative::scaleTimePacked - 1) : TPC_MAX_TIME_BIN_TRIGGERED;
-  GPUCA_OPENMP(parallel for firstprivate(offset, lasti))
+  const bool diffs = clustersCompressed->nComppressionModes & GPUSettings::CompressionDifferences;
+
+  // The tracks are split in contiguous blocks, each block writes its attached clusters of a given row into its own range of the output buffer.
+  // Blocks are ordered by track index, so the attached clusters end up in track order, independently from the number of threads.
+  const unsigned int nBlocks = std::max<unsigned int>(1, std::min<unsigned int>(nThreads, clustersCompressed->nTracks));
+  std::vector<unsigned int> trackOffsets(clustersCompressed->nTracks + 1);
+  trackOffsets[0] = 0;
   for (unsigned int i = 0; i < clustersCompressed->nTracks; i++) {
-    if (i < lasti) {
-      offset = lasti = 0; // dynamic OMP scheduling, need to reinitialize offset
-    }
-    while (lasti < i) {
-      offset += clustersCompressed->nTrackClusters[lasti++];
+    trackOffsets[i + 1] = trackOffsets[i] + clustersCompressed->nTrackClusters[i];
+  }
+  auto blockBegin = [clustersCompressed, nBlocks](unsigned int iBlock) { return (unsigned int)((size_t)clustersCompressed->nTracks * iBlock / nBlocks); };
+
+  // First pass: count the attached clusters per block and row. Slice and row are stored as differences, and do not need the track model.
+  auto blockCounts = std::make_unique<unsigned int[][NSLICES][GPUCA_ROW_COUNT]>(nBlocks);
+  GPUCA_OPENMP(parallel for num_threads(nBlocks))
+  for (unsigned int iBlock = 0; iBlock < nBlocks; iBlock++) {
+    auto& counts = blockCounts[iBlock];
+    for (unsigned int i = blockBegin(iBlock); i < blockBegin(iBlock + 1); i++) {
+      if (clustersCompressed->nTrackClusters[i] == 0) {
+        continue;
+      }
+      unsigned int slice = clustersCompressed->sliceA[i];
+      unsigned int row = clustersCompressed->rowA[i];
+      counts[slice][row]++;
+      for (unsigned int k = trackOffsets[i] - i; k < trackOffsets[i + 1] - i - 1; k++) {
+        unsigned char tmpSlice = clustersCompressed->sliceLegDiffA[k];
+        if (tmpSlice >= NSLICES) {
+          tmpSlice -= NSLICES;
+        }
+        if (diffs) {
+          slice += tmpSlice;
+          if (slice >= NSLICES) {
+            slice -= NSLICES;
+          }
+          row += clustersCompressed->rowDiffA[k];
+          if (row >= GPUCA_ROW_COUNT) {
+            row -= GPUCA_ROW_COUNT;
+          }
+        } else {
+          slice = tmpSlice;
+          row = clustersCompressed->rowDiffA[k];
+        }
+        counts[slice][row]++;
+      }
     }
-    lasti++;
-    decompressTrack(clustersCompressed, param, maxTime, i, offset, clusters, locks);
   }
+
+  // Prefix sum: each row holds the attached clusters of all blocks, followed by the unattached clusters
   size_t nTotalClusters = clustersCompressed->nAttachedClusters + clustersCompressed->nUnattachedClusters;
   ClusterNative* clusterBuffer = allocator(nTotalClusters);
+  auto blockPtrs = std::make_unique<ClusterNative* [][NSLICES][GPUCA_ROW_COUNT]>(nBlocks);
+  size_t offset = 0;
+  for (unsigned int i = 0; i < NSLICES; i++) {
+    for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
+      for (unsigned int iBlock = 0; iBlock < nBlocks; iBlock++) {
+        blockPtrs[iBlock][i][j] = clusterBuffer + offset;
+        offset += blockCounts[iBlock][i][j];
+      }
+      offset += nUnattached(i, j);
+    }
+  }
+  if (offset > nTotalClusters) {
+    throw std::runtime_error("Bad TPC CTF data, number of clusters exceeds announced number");
+  }
+
+  // Second pass: decode the tracks directly into the output buffer
+  GPUCA_OPENMP(parallel for num_threads(nBlocks))
+  for (unsigned int iBlock = 0; iBlock < nBlocks; iBlock++) {
+    for (unsigned int i = blockBegin(iBlock); i < blockBegin(iBlock + 1); i++) {
+      unsigned int trackOffset = trackOffsets[i];
+      decompressTrack(clustersCompressed, param, maxTime, i, trackOffset, blockPtrs[iBlock]);
+    }
+  }
+
+  // Clusters rejected by the track model leave gaps at the end of the block ranges, which are removed here
   unsigned int offsets[NSLICES][GPUCA_ROW_COUNT];
-  offset = 0;
   unsigned int decodedAttachedClusters = 0;
+  unsigned int unattachedOffset = 0;
+  ClusterNative* dest = clusterBuffer;
+  offset = 0;
   for (unsigned int i = 0; i < NSLICES; i++) {
     for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
-      clustersNative.nClusters[i][j] = clusters[i][j].size() + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
-      offsets[i][j] = offset;
-      offset += (i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j];
-      decodedAttachedClusters += clusters[i][j].size();
+      unsigned int nAttached = 0;
+      for (unsigned int iBlock = 0; iBlock < nBlocks; iBlock++) {
+        ClusterNative* begin = clusterBuffer + offset;
+        unsigned int n = blockPtrs[iBlock][i][j] - begin;
+        if (dest != begin && n) {
+          memmove((void*)dest, (const void*)begin, n * sizeof(clusterBuffer[0]));
+        }
+        dest += n;
+        nAttached += n;
+        offset += blockCounts[iBlock][i][j];
+      }
+      clustersNative.nClusters[i][j] = nAttached + nUnattached(i, j);
+      offsets[i][j] = unattachedOffset;
+      unattachedOffset += nUnattached(i, j);
+      dest += nUnattached(i, j);
+      offset += nUnattached(i, j);
+      decodedAttachedClusters += nAttached;
     }
   }
   if (decodedAttachedClusters != clustersCompressed->nAttachedClusters) {
@@ -82,16 +156,12 @@ int TPCClusterDecompressor::decompress(const CompressedClusters* clustersCompres
   }
   clustersNative.clustersLinear = clusterBuffer;
   clustersNative.setOffsetPtrs();
-  GPUCA_OPENMP(parallel for)
+  GPUCA_OPENMP(parallel for num_threads(nThreads))
   for (unsigned int i = 0; i < NSLICES; i++) {
     for (unsigned int j = 0; j < GPUCA_ROW_COUNT; j++) {
       ClusterNative* buffer = &clusterBuffer[clustersNative.clusterOffset[i][j]];
-      if (clusters[i][j].size()) {
-        memcpy((void*)buffer, (const void*)clusters[i][j].data(), clusters[i][j].size() * sizeof(clusterBuffer[0]));
-      }
-      ClusterNative* clout = buffer + clusters[i][j].size();
-      unsigned int end = offsets[i][j] + ((i * GPUCA_ROW_COUNT + j >= clustersCompressed->nSliceRows) ? 0 : clustersCompressed->nSliceRowClusters[i * GPUCA_ROW_COUNT + j]);
-      decompressHits(clustersCompressed, offsets[i][j], end, clout);
+      ClusterNative* clout = buffer + clustersNative.nClusters[i][j] - nUnattached(i, j);
+      decompressHits(clustersCompressed, offsets[i][j], offsets[i][j] + nUnattached(i, j), clout);
       if (param.rec.tpc.clustersShiftTimebins != 0.f) {
         for (unsigned int k = 0; k < clustersNative.nClusters[i][j]; k++) {
           auto& cl = buffer[k];
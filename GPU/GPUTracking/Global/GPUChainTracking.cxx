@@ -808,7 +808,7 @@ int GPUChainTracking::RunChainFinalize()
 #ifdef GPUCA_HAVE_O2HEADERS
   if (mIOPtrs.clustersNative && (GetRecoSteps() & RecoStep::TPCCompression) && GetProcessingSettings().runCompressionStatistics) {
     CompressedClusters c = *mIOPtrs.tpcCompressedClusters;
-    mCompressionStatistics->RunStatistics(mIOPtrs.clustersNative, &c, param());
+    mCompressionStatistics->RunStatistics(mIOPtrs.clustersNative, &c, param(), GetProcessingSettings().ompThreads);
   }
 #endif
 
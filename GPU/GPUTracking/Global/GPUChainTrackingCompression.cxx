@@ -217,7 +217,7 @@ int GPUChainTracking::RunTPCDecompression()
     };
     auto& gatherTimer = getTimer<TPCClusterDecompressor>("TPCDecompression", 0);
     gatherTimer.Start();
-    if (decomp.decompress(mIOPtrs.tpcCompressedClusters, *mClusterNativeAccess, allocator, param(), GetProcessingSettings().deterministicGPUReconstruction)) {
+    if (decomp.decompress(mIOPtrs.tpcCompressedClusters, *mClusterNativeAccess, allocator, param(), GetProcessingSettings().ompThreads, GetProcessingSettings().deterministicGPUReconstruction)) {
       GPUError("Error decompressing clusters");
       return 1;
     }
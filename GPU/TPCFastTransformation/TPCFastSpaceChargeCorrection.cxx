@@ -246,6 +246,55 @@ void TPCFastSpaceChargeCorrection::print() const
   }
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastSpaceChargeCorrection::getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const
+{
+  /// The points are processed in blocks: first the grid coordinates of the block are computed
+  /// in a branch-free loop, as in schrinkUV() and convUVtoGrid(), then the spline is evaluated.
+
+  const SplineType& spline = getSpline(slice, row);
+  const float* splineData = getSplineData(slice, row);
+  const SliceRowInfo& info = getSliceRowInfo(slice, row);
+  const TPCFastTransformGeo::RowInfo& rowInfo = mGeo.getRowInfo(row);
+
+  const float uWidth05 = rowInfo.getUwidth() * (0.5f + fInterpolationSafetyMargin);
+  const float vWidth = mGeo.getTPCzLength(slice);
+  const float vMin = -0.1f * vWidth;
+  const float vMax = 1.1f * vWidth;
+  float su0 = 0.f, sv0 = 0.f;
+  mGeo.convUVtoScaledUV(slice, row, 0.f, info.gridV0, su0, sv0);
+  const float gridUmax = spline.getGridX1().getUmax();
+  const float gridVmax = spline.getGridX2().getUmax();
+
+  constexpr int BlockSize = 64;
+  float gridU[BlockSize], gridV[BlockSize];
+  for (int i0 = 0; i0 < n; i0 += BlockSize) {
+    const int nb = (n - i0 < BlockSize) ? n - i0 : BlockSize;
+    const float* ub = u + i0;
+    const float* vb = v + i0;
+    for (int i = 0; i < nb; i++) {
+      float uc = ub[i] < -uWidth05 ? -uWidth05 : ub[i];
+      uc = uc > uWidth05 ? uWidth05 : uc;
+      float vc = vb[i] < vMin ? vMin : vb[i];
+      vc = vc > vMax ? vMax : vc;
+      float su = 0.f, sv = 0.f;
+      mGeo.convUVtoScaledUV(slice, row, uc, vc, su, sv);
+      gridU[i] = su * gridUmax;
+      gridV[i] = (sv - sv0) / (1.f - sv0) * gridVmax;
+    }
+    for (int i = 0; i < nb; i++) {
+      float dxuv[3];
+      spline.interpolateU(splineData, gridU[i], gridV[i], dxuv);
+      dx[i0 + i] = dxuv[0];
+      du[i0 + i] = dxuv[1];
+      dv[i0 + i] = dxuv[2];
+    }
+  }
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE)
 
 void TPCFastSpaceChargeCorrection::startConstruction(const TPCFastTransformGeo& geo, int numberOfSplineScenarios)
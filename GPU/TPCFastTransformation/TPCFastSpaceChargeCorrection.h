@@ -161,6 +161,12 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   ///
   GPUd() int getCorrection(int slice, int row, float u, float v, float& dx, float& du, float& dv) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// Correction of n points of the same row, gives the same result as getCorrection() called for each point.
+  /// The row-dependent parameters of the grid conversion are computed once for all the points.
+  void getCorrection(int slice, int row, int n, const float* u, const float* v, float* dx, float* du, float* dv) const;
+#endif
+
   /// inverse correction: Corrected U and V -> coorrected X
   GPUd() void getCorrectionInvCorrectedX(int slice, int row, float corrU, float corrV, float& corrX) const;
 
@@ -165,6 +165,77 @@ void TPCFastTransform::print() const
 #endif
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastTransform::TransformBatch(int slice, int n, const int* row, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime, const TPCFastTransform* ref, const TPCFastTransform* ref2, float scale, float scale2, int scaleMode) const
+{
+  /// Same steps as in Transform() and TransformInternal(), done for blocks of clusters of the same row
+
+  bool batchCorrection = mApplyCorrection && ((scale >= 0.f) || (scaleMode == 1) || (scaleMode == 2)) && !mCorrectionSlow;
+  GPUCA_DEBUG_STREAMER_CHECK(if (o2::utils::DebugStreamer::checkStream(o2::utils::StreamFlags::streamFastTransform)) { batchCorrection = false; });
+  if (!batchCorrection) { // nothing to gain w/o the spline correction
+    for (int i = 0; i < n; i++) {
+      Transform(slice, row[i], pad[i], time[i], x[i], y[i], z[i], vertexTime, ref, ref2, scale, scale2, scaleMode);
+    }
+    return;
+  }
+
+  constexpr int BlockSize = 64;
+  float u[BlockSize], v[BlockSize], dx[BlockSize], du[BlockSize], dv[BlockSize];
+  float dxRef[BlockSize], duRef[BlockSize], dvRef[BlockSize];
+
+  for (int i0 = 0; i0 < n;) {
+    const int iRow = row[i0];
+    int nb = 1;
+    while (nb < BlockSize && i0 + nb < n && row[i0 + nb] == iRow) {
+      nb++;
+    }
+    for (int i = 0; i < nb; i++) {
+      convPadTimeToUV(slice, iRow, pad[i0 + i], time[i0 + i], u[i], v[i], vertexTime);
+    }
+    mCorrection.getCorrection(slice, iRow, nb, u, v, dx, du, dv);
+    if (ref) {
+      if ((scale > 0.f) && (scaleMode == 0)) { // scaling was requested
+        ref->mCorrection.getCorrection(slice, iRow, nb, u, v, dxRef, duRef, dvRef);
+        for (int i = 0; i < nb; i++) {
+          dx[i] = (dx[i] - dxRef[i]) * scale + dxRef[i];
+          du[i] = (du[i] - duRef[i]) * scale + duRef[i];
+          dv[i] = (dv[i] - dvRef[i]) * scale + dvRef[i];
+        }
+      } else if ((scale != 0.f) && ((scaleMode == 1) || (scaleMode == 2))) {
+        ref->mCorrection.getCorrection(slice, iRow, nb, u, v, dxRef, duRef, dvRef);
+        for (int i = 0; i < nb; i++) {
+          dx[i] = dxRef[i] * scale + dx[i];
+          du[i] = duRef[i] * scale + du[i];
+          dv[i] = dvRef[i] * scale + dv[i];
+        }
+      }
+    }
+    if (ref2 && (scale2 != 0)) {
+      ref2->mCorrection.getCorrection(slice, iRow, nb, u, v, dxRef, duRef, dvRef);
+      for (int i = 0; i < nb; i++) {
+        dx[i] = dxRef[i] * scale2 + dx[i];
+        du[i] = duRef[i] * scale2 + du[i];
+        dv[i] = dvRef[i] * scale2 + dv[i];
+      }
+    }
+    const float rowX = getGeometry().getRowInfo(iRow).x;
+    for (int i = 0; i < nb; i++) {
+      float& xi = x[i0 + i];
+      float& yi = y[i0 + i];
+      float& zi = z[i0 + i];
+      xi = rowX + dx[i];
+      getGeometry().convUVtoLocal(slice, u[i] + du[i], v[i] + dv[i], yi, zi);
+      float dzTOF = 0;
+      getTOFcorrection(slice, iRow, xi, yi, zi, dzTOF);
+      zi += dzTOF;
+    }
+    i0 += nb;
+  }
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) && !defined(GPUCA_ALIROOT_LIB)
 
 int TPCFastTransform::writeToFile(std::string outFName, std::string name)
@@ -67,7 +67,8 @@ class Dispatcher : public framework::Task
   DataSamplingHeader prepareDataSamplingHeader(const DataSamplingPolicy& policy);
   header::Stack extractAdditionalHeaders(const char* inputHeaderStack) const;
   void reportStats(monitoring::Monitoring& monitoring) const;
-  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const framework::Output& output) const;
+  /// Sends the sampled payload. If the message holding it is provided, it is shared instead of copied.
+  void send(framework::DataAllocator& dataAllocator, const framework::DataRef& inputData, const fair::mq::Message* inputMessage, const framework::Output& output) const;
 
   std::string mName;
   DataSamplingHeader::DeviceIDType mDeviceID = "invalid";
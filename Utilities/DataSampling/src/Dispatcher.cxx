@@ -29,6 +29,7 @@
 
 #include <Configuration/ConfigurationInterface.h>
 #include <Configuration/ConfigurationFactory.h>
+#include <fairmq/Message.h>
 
 using namespace o2::configuration;
 using namespace o2::monitoring;
@@ -100,7 +101,8 @@ void Dispatcher::run(ProcessingContext& ctx)
       if (auto route = policy->match(inputMatcher); route != nullptr && policy->decide(firstPart)) {
         auto routeAsConcreteDataType = DataSpecUtils::asConcreteDataTypeMatcher(*route);
         auto dsheader = prepareDataSamplingHeader(*policy);
-        for (const auto& part : inputIt) {
+        for (size_t partIdx = 0; partIdx < inputIt.size(); partIdx++) {
+          const DataRef part = inputIt.getByPos(partIdx);
           if (part.header != nullptr) {
             // We copy every header which is not DataHeader or DataProcessingHeader,
             // so that custom data-dependent headers are passed forward,
@@ -115,7 +117,7 @@ void Dispatcher::run(ProcessingContext& ctx)
               routeAsConcreteDataType.description,
               partInputHeader->subSpecification,
               std::move(headerStack)};
-            send(ctx.outputs(), part, output);
+            send(ctx.outputs(), part, ctx.inputs().getPayloadMessageByPos(inputIt.position(), partIdx), output);
           }
         }
       }
@@ -170,10 +172,15 @@ header::Stack Dispatcher::extractAdditionalHeaders(const char* inputHeaderStack)
   return headerStack;
 }
 
-void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const Output& output) const
+void Dispatcher::send(DataAllocator& dataAllocator, const DataRef& inputData, const fair::mq::Message* inputMessage, const Output& output) const
 {
   const auto* inputHeader = DataRefUtils::getHeader<header::DataHeader*>(inputData);
-  dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  if (inputMessage != nullptr && inputMessage->GetSize() == DataRefUtils::getPayloadSize(inputData)) {
+    // No need to copy the payload, we just send another reference to the same message.
+    dataAllocator.shallowSnapshot(output, *inputMessage, inputHeader->payloadSerializationMethod);
+  } else {
+    dataAllocator.snapshot(output, inputData.payload, DataRefUtils::getPayloadSize(inputData), inputHeader->payloadSerializationMethod);
+  }
 }
 
 void Dispatcher::registerPolicy(std::unique_ptr<DataSamplingPolicy>&& policy)